@@ -8,6 +8,9 @@
 #ifndef HEADER_H
 #define HEADER_H
 
+#include <stdio.h>
+#include <gmp.h>
+
 /* ---------------------------------------------------------
                        Fp PART
 -----------------------------------------------------------*/
@@ -57,6 +60,39 @@ int fp2_is_zero( fp2 *a, mpz_t p );
 void fp2_set( fp2 *res, fp2 *a );
 	/* Sets fields from res with fields from a.
 	*/
+void fp2_batch_multinv( int n, fp2 res[n], fp2 a[n], mpz_t p );
+	/* Fills res[i] with the multiplicative inverse of a[i], using
+	Montgomery's trick, ie a single inversion for the n elements.
+	WATCH OUT ! None of the a[i] can be zero.
+	*/
+void fp2_pow_ui( fp2 *res, fp2 *a, unsigned long e, mpz_t p );
+	/* Sets res as a^e.
+	*/
+void fp2_pow( fp2 *res, fp2 *a, mpz_t e, mpz_t p );
+	/* Sets res as a^e, with e >= 0.
+	*/
+int fp2_sqrt( fp2 *res, fp2 *a, mpz_t p );
+	/* Sets res as a square root of a and returns 1 if a is a square,
+	returns 0 otherwise.
+	WATCH OUT ! p has to be 3 mod 4.
+	*/
+size_t fp_bytes( mpz_t p );
+	/* Returns the number of bytes of an encoded element of Fp.
+	*/
+void fp_encode( unsigned char *out, mpz_t a, size_t len );
+	/* Writes a, with 0 <= a < 2^(8len), on len bytes, little endian.
+	*/
+void fp_decode( mpz_t a, const unsigned char *in, size_t len );
+	/* Sets a from the len bytes of in, little endian, without copy
+	outside of the limbs of a.
+	*/
+void fp2_encode( unsigned char *out, fp2 *a, mpz_t p );
+	/* Writes s0 then s1, on fp_bytes( p ) bytes each.
+	*/
+int fp2_decode( fp2 *a, const unsigned char *in, mpz_t p );
+	/* Sets a from the 2*fp_bytes( p ) bytes of in, and returns 1 if
+	both coordinates are reduced mod p, 0 otherwise.
+	*/
 
 /* ---------------------------------------------------------
                     CURVE & POINT PART
@@ -214,6 +250,20 @@ void Ladder3pt_without_conversion( point *QplusmP, mpz_t m,
 	using the Montgomery ladder on curve F = (A : C).
 	WATCH OUT : assert that F is in the form (A+2C : 4C) ! 
 	*/
+fp2 *ladder_table_new( int n, fp2 *xQ, curve *F, mpz_t p );
+	/* Returns the table of the x([2^i]Q) - 1 and x([2^i]Q) + 1 for 
+	0 <= i < n, normalized with a single inversion, for Ladder3pt_table.
+	WATCH OUT ! F has to be in the form ( A+2C : 4C ).
+	*/
+void ladder_table_free( int n, fp2 *table );
+	/* Frees a table given by ladder_table_new.
+	*/
+int Ladder3pt_table( point *QplusmP, mpz_t m, 
+	fp2 *xP, int n, fp2 table[2*n], fp2 *xQminusP, mpz_t p );
+	/* Same as Ladder3pt, with the doublings of Q read from the table
+	given by ladder_table_new( n, xQ, ... ). No curve is needed.
+	Returns 0, without setting QplusmP, if m has more than n bits.
+	*/
 void jInvariant( fp2 *j, 
 	curve *E, mpz_t p );
 	/* Returns j invariant from curve E.
@@ -223,6 +273,28 @@ void get_A( fp2 *A,
 	/* Sets A as the first parameter of a curve passing through
 	xP, xQ and x(Q-P).
 	*/
+void jInvariant_projective( fp2 *num, fp2 *den, curve *E, mpz_t p );
+	/* Sets ( num : den ) as the j invariant of curve E, without inversion.
+	*/
+int j_are_equal( fp2 *num1, fp2 *den1, fp2 *num2, fp2 *den2, mpz_t p );
+	/* Returns 1 if the j invariants ( num1 : den1 ) and ( num2 : den2 )
+	are equal, by cross multiplication, and 0 otherwise.
+	*/
+void jInvariant_batch( int n, fp2 j[n], curve E[n], mpz_t p );
+	/* Sets j[i] as the j invariant of E[i], for 0 <= i < n, with a
+	single inversion.
+	WATCH OUT ! None of the curves can be singular.
+	*/
+void get_A_batch( int n, fp2 A[n], 
+	fp2 *xP[n], fp2 *xQ[n], fp2 *xQminusP[n], mpz_t p );
+	/* Sets A[i] as the first parameter of a curve passing through
+	xP[i], xQ[i] and x(Q-P)[i], for 0 <= i < n, with a single inversion.
+	WATCH OUT ! None of the abscissas can be zero.
+	*/
+int check_A( fp2 *A, fp2 *xP, fp2 *xQ, fp2 *xQminusP, mpz_t p );
+	/* Returns 1 if A is the parameter of the curve passing through
+	xP, xQ and x(Q-P) ( the one given by get_A ), without inversion.
+	*/
 void criss_cross( point *S, 
 	point *P, point *Q, mpz_t p );
 	/* Sets S as ( XP*ZQ + ZP*XQ : XP*ZQ - ZP*XQ ).
@@ -240,9 +312,146 @@ void curve_from_Alpha( curve *F,
 	Note : doesn't follows the paper which gives ( A-2C/4, C)
 	*/
 
+/* ---------------------------------------------------------
+                   CONSTANT TIME PART
+-----------------------------------------------------------*/
+
+void Ladder_ct( point *R, point *P, curve *F, mpz_t m, int bits, mpz_t p );
+	/* Sets R as [m]P, with addition on curve F, in constant time :
+	the ladder always runs on bits bits.
+	WATCH OUT ! F has to be in the form ( A+2C : 4C ), and m < 2^bits.
+	*/
+void Ladder3pt_ct( point *QplusmP, mpz_t m, int bits,
+	fp2 *xP, fp2 *xQ, fp2 *xQminusP, curve *F, mpz_t p );
+	/* Same as Ladder3pt_without_conversion, in constant time : the ladder 
+	always runs on bits bits, with conditional swaps.
+	WATCH OUT ! F has to be in the form ( A+2C : 4C ), and m < 2^bits.
+	*/
+
+/* ---------------------------------------------------------
+                     POLYNOMIAL PART
+-----------------------------------------------------------*/
+
+typedef struct poly_tree {
+	int k;
+	fp2 *f;
+	struct poly_tree *left;
+	struct poly_tree *right;
+} poly_tree;
+	/* Product tree : f is the product of the polynomials (x - root)
+	over the k roots below this node, with k+1 coefficients.
+	*/
+
+fp2 *poly_new( int n );
+	/* Allocates and initializes a polynomial with n coefficients,
+	all set to 0. Coefficients are stored with lowest degree first.
+	*/
+void poly_free( int n, fp2 *f );
+	/* Clears the n coefficients of f, and frees f.
+	*/
+void poly_mult( fp2 *h, fp2 *f, int n, fp2 *g, int m, mpz_t p );
+	/* Sets h as f*g, where f has n coefficients and g has m coefficients.
+	h has n+m-1 coefficients, and may not overlap f or g.
+	*/
+void poly_rem_monic( fp2 *r, fp2 *f, int n, fp2 *g, int m, mpz_t p );
+	/* Sets r as f mod g, where f has n coefficients and g has m coefficients.
+	r has m-1 coefficients.
+	WATCH OUT ! g has to be monic.
+	*/
+void poly_product( fp2 *h, int k, int deg, fp2 *fac, mpz_t p );
+	/* Sets h as the product of the k polynomials of degree deg stored
+	one after the other in fac. h has k*deg+1 coefficients.
+	*/
+void poly_tree_build( poly_tree *T, int k, fp2 roots[k], mpz_t p );
+	/* Builds the product tree of the k linear polynomials (x - roots[i]).
+	*/
+void poly_tree_clear( poly_tree *T );
+	/* Clears and frees every node of the product tree T.
+	*/
+void poly_tree_eval_prod( fp2 *res, poly_tree *T, fp2 *f, int n, mpz_t p );
+	/* Sets res as the product of the f(roots[i]) over the roots of T, 
+	ie the resultant of T and f, using a remainder tree.
+	*/
+long poly_mult_cost( int n, int m );
+long poly_rem_cost( int n, int m );
+long poly_product_cost( int k, int deg );
+long poly_tree_build_cost( int k );
+long poly_tree_eval_prod_cost( int k, int n );
+	/* Return the number of fp2 multiplications done by the 
+	corresponding method, with the same sizes as inputs.
+	*/
+
+/* ---------------------------------------------------------
+                       POOL PART
+-----------------------------------------------------------*/
+
+typedef struct pool pool;
+	/* Pool of worker threads, defined in pool.c.
+	*/
+
+pool *pool_new( int threads );
+	/* Returns a pool running its tasks on threads threads,
+	the calling one included.
+	*/
+void pool_free( pool *W );
+	/* Stops the workers of W and frees it.
+	*/
+int pool_threads( pool *W );
+	/* Returns the number of threads of W, 1 if W is NULL.
+	*/
+void pool_run( pool *W, int n, void (*job)( void *arg, int i ), void *arg );
+	/* Runs job( arg, i ) for 0 <= i < n on the threads of W, and returns 
+	when they are all done. Runs them in order if W is NULL.
+	WATCH OUT ! job must not call pool_run on the same pool.
+	*/
+
+/* ---------------------------------------------------------
+                      RANDOM PART
+-----------------------------------------------------------*/
+
+#define DRBG_KEY_BYTES 32
+#define DRBG_BUFFER 1056 // with the key, 8 blocks of SHAKE256 per refill.
+
+typedef struct drbg {
+	/* Buffered generator : the buffer and the next key are 
+	SHAKE256( key || counter ), the key coming first from getrandom.
+	A drbg must not be shared by several threads.
+	*/
+	unsigned char key[DRBG_KEY_BYTES];
+	unsigned long long counter;
+	unsigned char buf[DRBG_BUFFER];
+	size_t pos; // bytes of buf already given.
+} drbg;
+
+void random_bytes( unsigned char *out, size_t len );
+	/* Sets out as len random bytes from the kernel (getrandom).
+	*/
+void drbg_init( drbg *D );
+	/* Initializes D with a seed from the kernel.
+	*/
+void drbg_clear( drbg *D );
+	/* Erases the state of D.
+	*/
+void drbg_bytes( drbg *D, unsigned char *out, size_t len );
+	/* Sets out as the len next bytes of D, or as len bytes from the
+	kernel if D is NULL.
+	*/
+
 /* ---------------------------------------------------------
                      ISOGENY PART
 -----------------------------------------------------------*/
+void two_iso_curve( curve *F, point *P2, mpz_t p );
+	/* Sets F as the two-isogenous curve, ie F = E/<P2>, with P2 of order 2
+	different from (0 : 1).
+	WATCH OUT : F will be in the form AplusC = (A+2C : 4C)
+	*/
+void two_iso_eval( point *Q, point *P2, point *P, mpz_t p );
+	/* Sets Q as phi(P), where phi is the two-isogeny of kernel <P2>.
+	*/
+void two_iso_eval_batch( int n, point *Q[n], point *P2, point *P[n], mpz_t p );
+	/* Sets Q[i] as phi(P[i]) for the n points, where phi is the two-isogeny
+	of kernel <P2>.
+	*/
 void four_iso_curve( curve *F, fp2 *K1, fp2 *K2, fp2 *K3, 
 	point *P4, mpz_t p );
 	/* Sets F as the four-isogenous curve, ie F = E/<P4>,
@@ -254,6 +463,11 @@ void four_iso_eval( point* Q,
 	/* Sets Q as phi(P), where phi is a four-isogeny,
 	described by K1, K2 and K3.
 	*/
+void four_iso_eval_batch( int n, point *Q[n], 
+	fp2 *K1, fp2 *K2, fp2 *K3, point *P[n], mpz_t p );
+	/* Sets Q[i] as phi(P[i]) for the n points, where phi is a
+	four-isogeny described by K1, K2 and K3, sharing the temporaries.
+	*/
 void three_iso_curve( curve *F, fp2 *K1, fp2 *K2, 
 	point* P, mpz_t p );
 	/* Sets F as the three-isogenous curve, ie F = E/<P>,
@@ -266,6 +480,11 @@ void three_iso_eval( point *phiP,
 	described by K1 and K2.
 	Note : Does not follows exactly the specification, error on line 3.
 	*/
+void three_iso_eval_batch( int n, point *Q[n], 
+	fp2 *K1, fp2 *K2, point *P[n], mpz_t p );
+	/* Sets Q[i] as phi(P[i]) for the n points, where phi is a
+	three-isogeny described by K1 and K2, sharing the temporaries.
+	*/
 void two_e_iso( curve *F, point *phiP1, point *phiP2, point *phiP3,
 	curve *E, point *S, point *P1, point *P2, point *P3, 
 	int e2, mpz_t p );
@@ -309,8 +528,16 @@ void simultaneous_odd_isogeny( point *R, point *Beta,
 	sets the two torsion point Beta as phi(Beta),
 	sets S1 as phi(P), S2 as phi(Q), S3 as phi(QminusP),
 	where phi is an odd isogeny with degree 2d+1 and kernel <G>.
+	F is left unchanged : see odd_e_iso_strategy for whole chains.
 	WATCH OUT ! F is in the form ( A+2C : 4C ) !
 	*/
+void simultaneous_odd_isogeny_pool( point *R, point *Beta, 
+	point *S1, point *S2, point *S3,
+	point *G, curve *F, point *P, point *Q, point *QminusP, 
+	mpz_t p, int d, pool *W );
+	/* Same as simultaneous_odd_isogeny, with the five images computed on
+	the threads of W (if not NULL), one pool job for the whole step.
+	*/
 void simultaneous_odd_isogeny_without_points( point *R, point *Beta, 
 	point *G, curve *F,
 	mpz_t p, int d );
@@ -318,6 +545,108 @@ void simultaneous_odd_isogeny_without_points( point *R, point *Beta,
 	where phi is an odd isogeny with degree 2d+1.
 	WATCH OUT ! F is in the form ( A+2C : 4C ) !
 	*/
+void odd_iso_curve( curve *E, int d, point ker[d], curve *F, mpz_t p );
+	/* Sets E as the codomain of the isogeny of kernel ker and domain F,
+	with the twisted Edwards formulas.
+	WATCH OUT ! The kernel has to be reshaped, and F, E are in the form
+	( A+2C : 4C ) !
+	*/
+typedef struct sqrt_velu {
+	int l;
+	int b;
+	int bp;
+	int nk;
+	fp2 *xJ;
+	fp2 *tJ;
+	fp2 *xK;
+	poly_tree hI;
+	fp2 A;
+} sqrt_velu;
+	/* Precomputations for an l-isogeny with the square-root Velu formulas.
+	xJ and xK are the affine x([s]G) for s in J and K, tJ = xj² + 1 + 2A xj,
+	and hI is the product tree of ( x - x([i]G) ) for i in I.
+	b = #J, bp = #I, nk = #K, and A is the affine curve coefficient.
+	*/
+
+void sqrt_velu_init( sqrt_velu *V, int l, point *G, curve *F, mpz_t p );
+	/* Precomputes V for the l-isogeny of kernel <G>, with G a l torsion point.
+	WATCH OUT ! F has to be in the form (A+2C : 4C), and l >= 5.
+	*/
+void sqrt_velu_clear( sqrt_velu *V );
+	/* Clears the fields of V.
+	*/
+void sqrt_velu_eval( point *S, sqrt_velu *V, point *P, mpz_t p );
+	/* Sets S as phi(P), where phi is the isogeny described by V.
+	Same result as odd_isogeny, in O~(sqrt(l)) instead of O(l).
+	*/
+void sqrt_velu_curve( curve *F, sqrt_velu *V, mpz_t p );
+	/* Sets F as the codomain of the isogeny described by V.
+	WATCH OUT ! F will be in the form (A+2C : 4C) !
+	*/
+long velu_cost( int l, int npoints );
+long sqrt_velu_cost( int l, int npoints );
+	/* Return the number of fp2 multiplications needed to compute the kernel
+	of an l-isogeny and evaluate npoints points, with the linear
+	Costello-Hisil formulas, or with the square-root Velu formulas.
+	*/
+int sqrt_velu_is_faster( int l, int npoints );
+	/* Returns 1 if the square-root Velu formulas are cheaper than the
+	linear ones for an l-isogeny evaluated on npoints points, 0 otherwise.
+	The operation counts are weighted with costs measured by bench_sqrt_velu,
+	so the shipped degrees ( l <= 19 ) use the linear formulas.
+	*/
+long ladder_cost( int m );
+	/* Returns the number of fp2 multiplications done by Ladder on [m].
+	*/
+
+void optimal_strategy( int n, int strategy[], long mul_cost, long eval_cost );
+	/* Sets strategy (n-1 values) as the optimal strategy for a chain of
+	n steps, given the costs of a multiplication by l and of an image.
+	*/
+int two_chain_step( int e2 );
+	/* Returns the number of doublings per step in the chain of a 2^e2 
+	isogeny : 2 for 4-isogenies, 3 for 8-isogenies, the cheapest.
+	*/
+int strategy_steps( int l, int e );
+	/* Returns the number of steps in the chain of an l^e isogeny.
+	*/
+int *strategy_new( int l, int e, int regular );
+	/* Returns an optimal strategy for an l^e isogeny, to be freed with free.
+	regular is set to 1 for two_e_iso_strategy and three_e_iso_strategy.
+	*/
+void two_e_iso_strategy( curve *F, int n, point *phiP[n],
+	curve *E, point *S, point *P[n], 
+	int e2, int strategy[], mpz_t p, pool *W );
+	/* Sets F = E/<S> with S of order 2^e2, and phiP[i] as the image of P[i],
+	following strategy, with the images computed on the pool W (or NULL).
+	WATCH OUT ! E and F are in AplusC form.
+	*/
+void three_e_iso_strategy( curve *F, int n, point *phiP[n],
+	curve *E, point *S, point *P[n], 
+	int e3, int strategy[], mpz_t p, pool *W );
+	/* Sets F = E/<S> with S of order 3^e3, and phiP[i] as the image of P[i],
+	following strategy, with the images computed on the pool W (or NULL).
+	WATCH OUT E and F are in the form AplusAmoins !
+	*/
+void two_e_iso_without_points( curve *F, curve *E, point *S, 
+	int e2, int strategy[], mpz_t p, pool *W );
+	/* Sets F = E/<S> with S of order 2^e2, evaluating no other point.
+	WATCH OUT ! E and F are in AplusC form.
+	*/
+void three_e_iso_without_points( curve *F, curve *E, point *S, 
+	int e3, int strategy[], mpz_t p, pool *W );
+	/* Sets F = E/<S> with S of order 3^e3, evaluating no other point.
+	WATCH OUT E and F are in the form AplusAmoins !
+	*/
+void odd_e_iso_strategy( curve *F, point *Beta, int n, point *phiP[n],
+	curve *E, point *S, point *P[n], 
+	int l, int e, int strategy[], mpz_t p, pool *W );
+	/* Sets F = E/<S> with S of order l^e, and phiP[i] as the image of P[i],
+	following strategy, with the images computed on the pool W (or NULL).
+	The curves are recovered from the two torsion point Beta if not NULL,
+	directly from the kernels otherwise.
+	WATCH OUT ! E and F are in the form ( A+2C : 4C ) !
+	*/
 
 /* ---------------------------------------------------------
         			PK, SK, PARAMETERS
@@ -328,12 +657,18 @@ typedef struct pk {
 	fp2 x1;
    	fp2 x2;
    	fp2 x3;
+   	fp2 A; // A/C of the curve, if extended is set.
+   	int extended;
 } pk;
 
 typedef struct sk {
 	mpz_t secret;
 } sk;
 
+typedef struct dlog_table dlog_table;
+	/* Tables of pk_compress, defined in compress.c.
+	*/
+
 typedef struct parameters {
    	int eA;
    	int eB;
@@ -347,6 +682,18 @@ typedef struct parameters {
    	fp2 xPB;
    	fp2 xQB;
    	fp2 xRB;
+   	int *strategyA; // set by set_prime.
+   	int *strategyB;
+   	pool *W; // NULL, or pool used for the images of the points.
+   	fp2 *tableA; // x([2^i]QA) -+ 1, set by set_points, see Ladder3pt_table.
+   	fp2 *tableB; // x([2^i]QB).
+   	int tableA_len;
+   	int tableB_len;
+   	int extended_pk; // see set_extended_pk.
+   	int validate_pk;
+   	int constant_time; // see set_constant_time.
+   	dlog_table *dlogA; // set by set_points, see dlog_table_new.
+   	dlog_table *dlogB;
 } parameters;
 
 void pk_init_none( pk *PK );
@@ -358,6 +705,23 @@ void pk_clear( pk *PK );
 void pk_print( pk *PK );
 	/* Prints the fields of public key PK.
 	*/
+void pk_get_A_batch( int n, fp2 A[n], pk PK[n], mpz_t p );
+	/* Sets A[i] as the parameter of the curve given by the abscissas 
+	of PK[i], for 0 <= i < n, with a single inversion ( see get_A ).
+	*/
+
+size_t pk_bytes( parameters *param );
+	/* Returns the number of bytes of an encoded public key : x1, x2,
+	x3, and beta for the generalized parameters.
+	*/
+void pk_encode( unsigned char *out, pk *PK, parameters *param );
+	/* Writes PK on pk_bytes( param ) bytes, little endian.
+	*/
+int pk_decode( pk *PK, const unsigned char *in, parameters *param );
+	/* Sets PK from the pk_bytes( param ) bytes of in, and returns 1 if 
+	every coordinate is reduced mod p, 0 otherwise.
+	WATCH OUT ! PK has to be initialized, and is not extended.
+	*/
 
 void sk_init( sk *SK, mpz_t secret );
 	/* Initializes secret key SK with secret value.
@@ -365,23 +729,60 @@ void sk_init( sk *SK, mpz_t secret );
 void sk_clear( sk *SK );
 	/* Clears the field of secret key SK.
 	*/
+void random_secret( mpz_t s, int l, int e, drbg *D );
+	/* Sets s uniformly in {0, ..., l^e-1}, from D (or the kernel if D
+	is NULL).
+	*/
+void sk_generate( sk *SK, int l, int e, drbg *D );
+	/* Initializes secret key SK with a uniform secret in {0, ..., l^e-1},
+	from D (or the kernel if D is NULL) : l^e = 2^eA or 3^eB for 2/3,
+	pA^eA or pB^eB for generalized parameters.
+	*/
+size_t sk_bytes( int l, int e );
+	/* Returns the number of bytes of an encoded secret mod l^e.
+	*/
+void sk_encode( unsigned char *out, sk *SK, int l, int e );
+	/* Writes the secret of SK, mod l^e, on sk_bytes( l, e ) bytes.
+	*/
+int sk_decode( sk *SK, const unsigned char *in, int l, int e );
+	/* Sets SK from the sk_bytes( l, e ) bytes of in, and returns 1 if
+	the secret is smaller than l^e, 0 otherwise.
+	*/
 
 void init_parameters( parameters *param );
 	/* Initializes public key PK with value 0 for every fields.
 	*/
 void set_prime( parameters *param, 
 	mpz_t p, int pA, int pB, int eA, int eB );
-	/* Sets the public parameters in param as given inputs.
+	/* Sets the public parameters in param as given inputs,
+	and computes the strategies for both sides.
 	*/
 void set_points( parameters *param, 
 	mpz_t alpha0, mpz_t alpha1, 
 	mpz_t xPA0, mpz_t xPA1, mpz_t xQA0, mpz_t xQA1, mpz_t xRA0, mpz_t xRA1,
 	mpz_t xPB0, mpz_t xPB1, mpz_t xQB0, mpz_t xQB1, mpz_t xRB0, mpz_t xRB1 );
-	/* Sets the public parameters in param as given inputs.
+	/* Sets the public parameters in param as given inputs, and the
+	tables of the doublings of QA and QB for key generation.
+	WATCH OUT ! set_prime has to be called first.
 	*/
 void clear_parameters( parameters *param );
 	/* Clears the fields of public parameters param.
 	*/
+void set_pool( parameters *param, pool *W );
+	/* Key generation and exchange will compute the images of the points
+	on the threads of W. W is not freed by clear_parameters.
+	*/
+void set_extended_pk( parameters *param, int extended, int validate );
+	/* If extended is set, key generation adds to the public keys the 
+	coefficient A of their curve, and key exchange uses it instead of 
+	recovering the curve. If validate is set, key exchange only uses it
+	after checking it against the points of the public key.
+	*/
+void set_constant_time( parameters *param, int ct );
+	/* If ct is set, key generation and exchange compute the kernel points
+	with Ladder3pt_ct, instead of Ladder3pt_table and Ladder3pt which 
+	branch on the bits of the secret. The isogenies are not constant time.
+	*/
 
 void isogen_two( pk *PK2, sk *SK2, parameters *param );
 	/* Key generation for the 2-isogeny side.
@@ -395,10 +796,18 @@ void isoex_two( fp2 *j, sk *SK2, pk *PK3, parameters *param );
 	/* Key exchange for the 2-isogeny side.
 	Sets jA as the shared secret.
 	*/
+void isoex_two_projective( fp2 *num, fp2 *den, sk *SK2, pk *PK3, parameters *param );
+	/* Same as isoex_two, with the j invariant given as ( num : den ), 
+	without inversion. Compare it with j_are_equal.
+	*/
 void isoex_three( fp2 *j, sk *SK3, pk *PK2, parameters *param );
 	/* Key exchange for the 3-isogeny side.
 	Sets jB as the shared secret.
 	*/
+void isoex_three_projective( fp2 *num, fp2 *den, sk *SK3, pk *PK2, parameters *param );
+	/* Same as isoex_three, with the j invariant given as ( num : den ), 
+	without inversion. Compare it with j_are_equal.
+	*/
 
 void isogen_Alice( pk *PKA, sk *SKA, parameters *param );
 	/* Key generation for any odd isogeny.
@@ -412,13 +821,232 @@ void isoex_Alice( fp2 *jA, pk *PKB, sk *SKA, parameters *param );
 	/* Key exchange for any odd isogeny.
 	Sets jA as the shared secret.
 	*/
+void isoex_Alice_projective( fp2 *num, fp2 *den, pk *PKB, sk *SKA, parameters *param );
+	/* Same as isoex_Alice, with the j invariant given as ( num : den ), 
+	without inversion. Compare it with j_are_equal.
+	*/
 void isoex_Bob( fp2 *jB, pk *PKA, sk *SKB, parameters *param );
 	/* Key exchange for any odd isogeny.
 	Sets jB as the shared secret.
 	*/
+void isoex_Bob_projective( fp2 *num, fp2 *den, pk *PKA, sk *SKB, parameters *param );
+	/* Same as isoex_Bob, with the j invariant given as ( num : den ), 
+	without inversion. Compare it with j_are_equal.
+	*/
+void isogen_batch( int n, pk PK[n], sk SK[n], int side, parameters *param, pool *W );
+	/* Sets PK[i] as the public key of SK[i] for 0 <= i < n, on the side
+	A ( isogen_two, isogen_Alice ) if side is 0, B otherwise. The keys 
+	are spread on the threads of W ( or NULL ) instead of their images, 
+	and the normalizations of the batch share a single inversion.
+	WATCH OUT ! The PK[i] have to be initialized.
+	*/
+
+/* ---------------------------------------------------------
+        			PARAMETER FILES
+-----------------------------------------------------------*/
+
+int param_read( parameters *param, const char *text );
+	/* Sets param ( set_prime, set_points ) from the parameter file text,
+	see params.c for the format. Returns 1 on success, and 0 with a 
+	message on stderr if the file is malformed, if p is not a prime 
+	= 3 mod 4 or if a coordinate is not reduced.
+	*/
+int param_load( parameters *param, const char *path );
+	/* Sets param from the parameter file path, see param_read.
+	*/
+void param_write( FILE *out, parameters *param );
+	/* Writes param as a parameter file.
+	*/
+int param_check( parameters *param );
+	/* Returns 1 if the abscissas of both sides have order l^e on the 
+	starting curve, and the bases are not degenerate at order l.
+	*/
+int param_set_count( void );
+	/* Returns the number of shipped parameter sets.
+	*/
+const char *param_set_name( int i );
+	/* Returns the name of the shipped set i, like "2/3" or "3/5".
+	*/
+int param_select( parameters *param, const char *name );
+	/* Sets param from the shipped set called name, or else from the
+	parameter file name. Returns 1 on success, 0 otherwise.
+	*/
+
+/* ---------------------------------------------------------
+        			PK COMPRESSION
+-----------------------------------------------------------*/
+
+typedef struct pk_compressed {
+	fp2 A; // coefficient of the curve of the key.
+	mpz_t s[3]; // scalars of phi(P) and phi(Q) in the basis, see pk_compress.
+	int normalized; // 0 if phi(P) = R1 + [s0]R2, 1 if phi(P) = [s0]R1 + R2.
+	int root; // root of x^2 + Ax + 1 giving beta, for the generalized parameters.
+} pk_compressed;
+
+void pkc_init_none( pk_compressed *CPK );
+	/* Initializes CPK with value 0 for every fields.
+	*/
+void pkc_clear( pk_compressed *CPK );
+	/* Clears the fields of CPK.
+	*/
+int torsion_basis_x( fp2 *xP, fp2 *xQ, fp2 *xR, fp2 *A, int l, int e, mpz_t p );
+	/* Sets xP, xQ and xR = x(P-Q) for a basis P, Q of E[l^e] depending only
+	on A, E : y^2 = x^3 + Ax^2 + x, with Q above (0,0) for l = 2. Returns 1
+	if a basis is found, 0 otherwise.
+	*/
+dlog_table *dlog_table_new( int l, int e, mpz_t p );
+	/* Returns the tables used by pk_compress for the points of order l^e :
+	the discrete logarithms in the subgroup of order l^e of Fp2*, in base
+	a generator w only depending on p, l and e, and the exponent of the
+	reduced Tate pairings. Returns NULL if no generator is found.
+	*/
+void dlog_table_free( dlog_table *D );
+	/* Frees a table given by dlog_table_new, or does nothing if D is NULL.
+	*/
+int pk_compress( pk_compressed *CPK, pk *PK, int l, int e, parameters *param );
+	/* Sets CPK as the compression of PK, whose points have order l^e
+	( pB^eB for the keys of the side A, pA^eA for the side B ), and 
+	returns 1, or returns 0 if PK can't be compressed.
+	phi(P) and phi(Q) are written in a basis ( R1, R2 ) of the l^e 
+	torsion only depending on A, with reduced Tate pairings and 
+	discrete logarithms, up to a common factor.
+	*/
+int pk_decompress( pk *PK, pk_compressed *CPK, int l, int e, parameters *param );
+	/* Sets PK as the public key compressed in CPK, and returns 1, or
+	returns 0 if CPK is not a valid compressed key. PK is extended with
+	the coefficient A of its curve.
+	*/
+size_t pkc_bytes( int l, int e, parameters *param );
+	/* Returns the number of bytes of an encoded compressed key.
+	*/
+void pkc_encode( unsigned char *out, pk_compressed *CPK, int l, int e, parameters *param );
+	/* Writes CPK on pkc_bytes( l, e, param ) bytes, little endian.
+	*/
+int pkc_decode( pk_compressed *CPK, const unsigned char *in, int l, int e, parameters *param );
+	/* Sets CPK from the pkc_bytes( l, e, param ) bytes of in, and returns
+	1 if A is reduced mod p and the scalars mod l^e, 0 otherwise.
+	*/
+
+/* ---------------------------------------------------------
+        				KEM
+-----------------------------------------------------------*/
+
+void shake256( unsigned char *out, size_t outlen,
+	const unsigned char *in, size_t inlen );
+	/* Sets out as the outlen first bytes of SHAKE256( in ).
+	*/
+
+#define KEM_BYTES 32 // length of the messages and of the shared secrets.
+
+typedef struct kem_sk {
+	unsigned char s[KEM_BYTES]; // hashed instead of the message on failure.
+	sk SK;
+	pk PK; // public key of SK, hashed into the ephemeral secrets.
+} kem_sk;
+
+typedef struct kem_ct {
+	pk c0; // ephemeral public key, with beta for the generalized parameters.
+	unsigned char c1[KEM_BYTES]; // message xor hash of the j invariant.
+} kem_ct;
+
+void kem_sk_init_none( kem_sk *SK );
+	/* Initializes SK with value 0 for every fields.
+	*/
+void kem_sk_clear( kem_sk *SK );
+	/* Clears the fields of SK.
+	*/
+void kem_ct_init_none( kem_ct *C );
+	/* Initializes C with value 0 for every fields.
+	*/
+void kem_ct_clear( kem_ct *C );
+	/* Clears the fields of C.
+	*/
+void kem_keygen( pk *PK, kem_sk *SK, parameters *param );
+	/* Key generation of the KEM, on the side B (3, or pB).
+	Sets SK with a random secret and PK as its public key.
+	*/
+void kem_encaps( unsigned char K[KEM_BYTES], kem_ct *C, pk *PK, parameters *param );
+	/* Encapsulation of the KEM, on the side A (2, or pA).
+	Sets C as a ciphertext for the public key PK, and K as the shared secret.
+	*/
+void kem_decaps( unsigned char K[KEM_BYTES], kem_ct *C, kem_sk *SK, parameters *param );
+	/* Decapsulation of the KEM, on the side B (3, or pB).
+	Sets K as the shared secret of C, or as a pseudo random value
+	if C is not a valid ciphertext.
+	*/
+
+/* ---------------------------------------------------------
+        				CONTEXT PART
+-----------------------------------------------------------*/
+
+/* Concurrency contract.
+- A parameters structure is set once ( set_prime, set_points, 
+set_pool, param_select... ) and then only read : any number 
+of threads may use it at the same time, as long as none of the set_ 
+functions nor clear_parameters is called meanwhile.
+- The functions of this library keep no other state, and there is no 
+global variable : their temporaries
+are local to each call, and the objects they write ( pk, sk, fp2, kem_sk,
+kem_ct, drbg ) belong to the caller. Objects that are only read, like a 
+public key, may be shared between threads.
+- A ctx belongs to one thread at a time. It holds the options a thread 
+may change ( pool, extended public keys ) on its own copy of the shared
+parameters, and a generator for the secrets. No lock is taken, except 
+inside the pool of a ctx if it has one : a pool runs one job at a time,
+so each ctx needs its own pool, or none.
+- The options of a ctx are local : the public keys and ciphertexts are
+exchanged and hashed through pk_encode, without the coefficient A, so 
+ctxs ( or parties ) with different extended public key options still 
+run the key exchange and the KEM together.
+*/
+
+typedef struct ctx {
+	parameters param; // shares the fields of the parameters, with its own options.
+	drbg D; // generator of the secrets of ctx_keygen.
+} ctx;
+
+void ctx_init( ctx *C, parameters *param );
+	/* Initializes C on the shared parameters param, without pool, and
+	seeds its generator. param has to outlive C.
+	*/
+void ctx_clear( ctx *C );
+	/* Clears C, but not the shared parameters.
+	*/
+void ctx_set_pool( ctx *C, pool *W );
+	/* Same as set_pool, for the calls on C only.
+	*/
+void ctx_set_extended_pk( ctx *C, int extended, int validate );
+	/* Same as set_extended_pk, for the calls on C only.
+	*/
+void ctx_set_constant_time( ctx *C, int ct );
+	/* Same as set_constant_time, for the calls on C only.
+	*/
+void ctx_isogen( ctx *C, pk *PK, sk *SK, int side );
+	/* Key generation of the side A ( 2 or pA ) if side is 0, B otherwise.
+	*/
+void ctx_keygen( ctx *C, pk *PK, sk *SK, int side );
+	/* Initializes SK with a uniform secret of the side, and sets PK as 
+	its public key, see ctx_isogen.
+	*/
+void ctx_keygen_batch( ctx *C, int n, pk PK[n], sk SK[n], int side );
+	/* Same as ctx_keygen for n keys, with isogen_batch on the pool of C.
+	*/
+void ctx_isoex( ctx *C, fp2 *j, sk *SK, pk *PK, int side );
+	/* Key exchange of the side A if side is 0, B otherwise : sets j as
+	the shared secret of SK and PK, the public key of the other side.
+	*/
+void ctx_kem_keygen( ctx *C, pk *PK, kem_sk *SK );
+	/* Same as kem_keygen, with the options of C.
+	*/
+void ctx_kem_encaps( ctx *C, unsigned char K[KEM_BYTES], kem_ct *CT, pk *PK );
+	/* Same as kem_encaps, with the options of C.
+	*/
+void ctx_kem_decaps( ctx *C, unsigned char K[KEM_BYTES], kem_ct *CT, kem_sk *SK );
+	/* Same as kem_decaps, with the options of C.
+	*/
 
 /* ---------------------------------------------------------
-        				MAIN
+        				WRAPPERS
 -----------------------------------------------------------*/
 
 void key_gen_Alice( pk *PKA, sk *SKA, parameters *param, int regular );
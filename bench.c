@@ -0,0 +1,1021 @@
+/*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*
+*
+* Contains benchmarks comparing several ways to compute
+* the same objects. Run them with "./Main bench".
+*
+*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include <gmp.h>
+#include "Header.h"
+#include "bench.h"
+
+double bench_time( void ) {
+	/* Returns a monotonic time in seconds.
+	*/
+	struct timespec t;
+	clock_gettime( CLOCK_MONOTONIC, &t );
+	return t.tv_sec + t.tv_nsec*1e-9;
+}
+
+/* --------------------------------------------------------
+                    CODOMAIN
+----------------------------------------------------------*/
+
+void bench_codomain( parameters *param, int iterations ) {
+	/* Compares, for one odd isogeny step of degree l = pA (if odd) and pB,
+	the codomain obtained by pushing the two torsion point through the 
+	isogeny and calling curve_from_Alpha, with the one given by 
+	odd_iso_curve. The key exchange uses the faster one, see exchange_beta.
+	*/
+	mpz_t q;
+	mpz_init( q );
+
+	curve E, F1, F2;
+	curve_init_none( &E );
+	curve_init_none( &F1 );
+	curve_init_none( &F2 );
+	curve_from_alpha( &E, &(param->alpha), param->p );
+	curve_normalize( &E, &E, param->p );
+
+	point R, G, Alpha, Beta;
+	point_init_none( &R );
+	point_init_none( &G );
+	point_init_none( &Beta );
+	point_init_normalize( &Alpha, &(param->alpha), param->p );
+	fp2 j1, j2;
+	fp2_init_none( &j1 );
+	fp2_init_none( &j2 );
+
+	for( int side = ( param->pA == 2 ); side < 2; side++ ) {
+		int l = side ? param->pB : param->pA;
+		int e = side ? param->eB : param->eA;
+		int d = ( l-1 )/2;
+		mpz_set_ui( q, 0 );
+		if( side ) {
+			Ladder3pt_without_conversion( &R, q, 
+				&(param->xPB), &(param->xQB), &(param->xRB), &E, param->p );
+		}
+		else {
+			Ladder3pt_without_conversion( &R, q, 
+				&(param->xPA), &(param->xQA), &(param->xRA), &E, param->p );
+		}
+		// Now R = P, since q = 0.
+		mpz_ui_pow_ui( q, l, e - 1 );
+		Ladder( &G, &R, &E, q, param->p );
+		// Now G has order l.
+
+		point ker[d];
+		for( int i = 0; i<d; i++ ) {
+			point_init_none( &(ker[i]) );
+		}
+
+		double t0 = bench_time();
+		for( int n = 0; n < iterations; n++ ) {
+			kernel_point( d, ker, &G, &E, param->p );
+			kernel_reshape( d, ker, param->p );
+			odd_isogeny( &Beta, d, ker, &Alpha, param->p );
+			curve_from_Alpha( &F1, &Beta, param->p );
+		}
+		double t1 = bench_time();
+		for( int n = 0; n < iterations; n++ ) {
+			kernel_point( d, ker, &G, &E, param->p );
+			kernel_reshape( d, ker, param->p );
+			odd_iso_curve( &F2, d, ker, &E, param->p );
+		}
+		double t2 = bench_time();
+
+		jInvariant( &j1, &F1, param->p );
+		jInvariant( &j2, &F2, param->p );
+
+		printf("Codomain of a %d-isogeny, %d iterations :\n", l, iterations );
+		printf("  with Beta       : %.3f us\n", ( t1-t0 )*1e6/iterations );
+		printf("  odd_iso_curve   : %.3f us\n", ( t2-t1 )*1e6/iterations );
+		printf("  same j-invariant : %d\n", fp2_are_equal( &j1, &j2 ) );
+
+		for( int i = 0; i<d; i++ ) {
+			point_clear( &(ker[i]) );
+		}
+	}
+
+	fp2_clear( &j1 );
+	fp2_clear( &j2 );
+	point_clear( &R );
+	point_clear( &G );
+	point_clear( &Alpha );
+	point_clear( &Beta );
+	curve_clear( &E );
+	curve_clear( &F1 );
+	curve_clear( &F2 );
+	mpz_clear( q );
+}
+
+/* --------------------------------------------------------
+                    THREADS
+----------------------------------------------------------*/
+
+void bench_threads( parameters *param, int threads, int iterations ) {
+	/* Compares the time of a key generation for both sides, with the
+	images of the points computed on a pool of threads threads, or
+	on the calling thread only.
+	*/
+	int regular = ( param->pA == 2 );
+	pool *W = pool_new( threads );
+	pool *saved = param->W;
+	pk PKA, PKB;
+	sk SKA, SKB;
+	pk_init_none( &PKA );
+	pk_init_none( &PKB );
+	sk_generate( &SKA, param->pA, param->eA, NULL );
+	sk_generate( &SKB, param->pB, param->eB, NULL );
+
+	printf("Key generation, %d iterations :\n", iterations );
+	for( int run = 0; run < 2; run++ ) {
+		set_pool( param, ( run == 0 ) ? NULL : W );
+
+		double t0 = bench_time();
+		for( int n = 0; n < iterations; n++ ) {
+			if( regular ) {
+				isogen_two( &PKA, &SKA, param );
+				isogen_three( &PKB, &SKB, param );
+			}
+			else {
+				isogen_Alice( &PKA, &SKA, param );
+				isogen_Bob( &PKB, &SKB, param );
+			}
+		}
+		double t1 = bench_time();
+		printf("  %d thread(s) : %.3f ms\n", pool_threads( param->W ), 
+			( t1-t0 )*1e3/iterations );
+	}
+
+	set_pool( param, saved );
+	pool_free( W );
+	pk_clear( &PKA );
+	pk_clear( &PKB );
+	sk_clear( &SKA );
+	sk_clear( &SKB );
+}
+
+/* --------------------------------------------------------
+                    EXCHANGE
+----------------------------------------------------------*/
+
+static int same_curve( curve *E, curve *F, mpz_t p ) {
+	/* Returns 1 if (E.A : E.C) = (F.A : F.C).
+	*/
+	fp2 t1, t2;
+	fp2_init_none( &t1 );
+	fp2_init_none( &t2 );
+	fp2_mult( &t1, &(E->A), &(F->C), p );
+	fp2_mult( &t2, &(F->A), &(E->C), p );
+	int same = fp2_are_equal( &t1, &t2 );
+	fp2_clear( &t1 );
+	fp2_clear( &t2 );
+	return same;
+}
+
+void bench_exchange( parameters *param, int iterations ) {
+	/* Compares, for the 2/3 parameters, the isogeny chains of the key 
+	exchange computed with two_e_iso and three_e_iso on dummy points,
+	with two_e_iso_without_points and three_e_iso_without_points.
+	Note : two_e_iso and three_e_iso overwrite their kernel point.
+	*/
+	if( param->pA != 2 ) {
+		printf("Exchange chains : 2/3 parameters only.\n");
+		return;
+	}
+	curve E, F0, F1, F2;
+	curve_init_ui( &E, 0, 0, 1, 0, param->p );
+	curve_init_none( &F1 );
+	curve_init_none( &F2 );
+	point S0, S, T;
+	point_init_none( &S0 );
+	point_init_none( &S );
+	point_init_none( &T );
+	mpz_t s;
+	mpz_init( s );
+	random_secret( s, 2, param->eA, NULL );
+	double t0, t1, t2;
+
+	Ladder3pt( &S0, s, &(param->xPA), &(param->xQA), &(param->xRA), &E, param->p );
+	curve_init_ui( &F0, 1, 0, 2, 0, param->p ); // (A+2C : 4C)
+
+	t0 = bench_time();
+	for( int n = 0; n < iterations; n++ ) {
+		point_set( &S, &S0 );
+		two_e_iso( &F1, &T, &T, &T, &F0, &S, &T, &T, &T, param->eA, param->p );
+	}
+	t1 = bench_time();
+	for( int n = 0; n < iterations; n++ ) {
+		two_e_iso_without_points( &F2, &F0, &S0, param->eA, 
+			param->strategyA, param->p, NULL );
+	}
+	t2 = bench_time();
+	printf("2^%d isogeny of the key exchange, %d iterations :\n", param->eA, iterations );
+	printf("  two_e_iso                : %.3f ms\n", ( t1-t0 )*1e3/iterations );
+	printf("  two_e_iso_without_points : %.3f ms\n", ( t2-t1 )*1e3/iterations );
+	printf("  same curve : %d\n", same_curve( &F1, &F2, param->p ) );
+
+	random_secret( s, 3, param->eB, NULL );
+	Ladder3pt( &S0, s, &(param->xPB), &(param->xQB), &(param->xRB), &E, param->p );
+	curve_clear( &F0 );
+	curve_init_ui( &F0, 2, 0, -2, 0, param->p ); // (A+2C : A-2C)
+
+	t0 = bench_time();
+	for( int n = 0; n < iterations; n++ ) {
+		point_set( &S, &S0 );
+		three_e_iso( &F1, &T, &T, &T, &F0, &S, &T, &T, &T, param->eB, param->p );
+	}
+	t1 = bench_time();
+	for( int n = 0; n < iterations; n++ ) {
+		three_e_iso_without_points( &F2, &F0, &S0, param->eB, 
+			param->strategyB, param->p, NULL );
+	}
+	t2 = bench_time();
+	printf("3^%d isogeny of the key exchange, %d iterations :\n", param->eB, iterations );
+	printf("  three_e_iso                : %.3f ms\n", ( t1-t0 )*1e3/iterations );
+	printf("  three_e_iso_without_points : %.3f ms\n", ( t2-t1 )*1e3/iterations );
+	printf("  same curve : %d\n", same_curve( &F1, &F2, param->p ) );
+
+	point_clear( &S0 );
+	point_clear( &S );
+	point_clear( &T );
+	curve_clear( &E );
+	curve_clear( &F0 );
+	curve_clear( &F1 );
+	curve_clear( &F2 );
+	mpz_clear( s );
+}
+
+/* --------------------------------------------------------
+                    SQUARE-ROOT VELU
+----------------------------------------------------------*/
+
+static void sqrt_velu_setup( mpz_t p, curve *E, point *G, point *P, int l, size_t bits ) {
+	/* Sets p as the first prime 4lf - 1 of about bits bits, E as the curve
+	y^2 = x^3 + x in the form (A+2C : 4C), G as a point of order l of E
+	and P as a point of order p+1 of E, so that the isogeny of kernel <G>
+	can be computed for any odd prime l.
+	*/
+	mpz_t f, q, a, b;
+	mpz_inits( f, q, a, b, NULL );
+	mpz_setbit( f, bits-2 );
+	mpz_tdiv_q_ui( f, f, l );
+	do {
+		mpz_add_ui( f, f, 1 );
+		mpz_mul_ui( p, f, 4*l );
+		mpz_sub_ui( p, p, 1 );
+	} while( !mpz_probab_prime_p( p, 30 ) );
+	curve_clear( E );
+	curve_init_ui( E, 2, 0, 4, 0, p );
+
+	fp2 x, y, s;
+	fp2_init_none( &y );
+	fp2_init_none( &s );
+	mpz_set_ui( b, 1 );
+	mpz_add_ui( q, p, 1 );
+	mpz_divexact_ui( q, q, l );
+	for( unsigned long k = 1; ; k++ ) {
+		// P is on E when x^3 + x is a square, and has order p+1 when [(p+1)/l]P is not 0.
+		mpz_set_ui( a, k );
+		fp2_init( &x, a, b, p );
+		fp2_mult( &y, &x, &x, p );
+		fp2_mult( &y, &y, &x, p );
+		fp2_add( &y, &y, &x, p );
+		if( fp2_sqrt( &s, &y, p ) ) {
+			point_clear( P );
+			point_init_normalize( P, &x, p );
+			Ladder( G, P, E, q, p );
+			if( !fp2_is_zero( &(G->Z), p ) ) {
+				fp2_clear( &x );
+				break;
+			}
+		}
+		fp2_clear( &x );
+	}
+
+	fp2_clear( &y );
+	fp2_clear( &s );
+	mpz_clears( f, q, a, b, NULL );
+}
+
+void bench_sqrt_velu( parameters *param, int npoints, int iterations ) {
+	/* Compares, for odd primes l up to 1511, an l-isogeny evaluated on 
+	npoints points with the linear Velu formulas and with the square-root
+	Velu formulas, on primes of the size of param->p, and checks that the
+	images and the codomains are the same. Prints the choice of
+	sqrt_velu_is_faster against the timings, and the ratios used to
+	calibrate its model : the time of an fp2_multinv in fp2_mult, and the
+	time of a multiplication counted by sqrt_velu_cost over the time of a
+	multiplication counted by velu_cost.
+	*/
+	int degrees[] = { 5, 13, 19, 31, 61, 101, 151, 251, 401, 601, 1009, 1511 };
+	int count = sizeof( degrees )/sizeof( degrees[0] );
+	size_t bits = mpz_sizeinbase( param->p, 2 );
+	mpz_t p, m;
+	mpz_inits( p, m, NULL );
+	curve E, F1, F2;
+	curve_init_none( &E );
+	curve_init_none( &F1 );
+	curve_init_none( &F2 );
+	point G, P, S1, S2;
+	point_init_none( &G );
+	point_init_none( &P );
+	point_init_none( &S1 );
+	point_init_none( &S2 );
+	point pts[npoints];
+	for( int i = 0; i < npoints; i++ ) {
+		point_init_none( &(pts[i]) );
+	}
+	fp2 x1, x2;
+	fp2_init_none( &x1 );
+	fp2_init_none( &x2 );
+
+	int agree = 0;
+	double velu_time = 0, sqrt_velu_time = 0;
+	long velu_mults = 0, sqrt_velu_mults = 0;
+	printf("Isogenies on %d points, p of %zu bits :\n", npoints, bits );
+	for( int n = 0; n < count; n++ ) {
+		int l = degrees[n];
+		int d = ( l-1 )/2;
+		int it = 1 + iterations*10/l;
+		sqrt_velu_setup( p, &E, &G, &P, l, bits );
+		for( int i = 0; i < npoints; i++ ) {
+			mpz_set_ui( m, 1000+i );
+			Ladder( &(pts[i]), &P, &E, m, p );
+		}
+		point ker[d];
+		for( int i = 0; i < d; i++ ) {
+			point_init_none( &(ker[i]) );
+		}
+
+		double t0 = bench_time();
+		for( int k = 0; k < it; k++ ) {
+			kernel_point( d, ker, &G, &E, p );
+			kernel_reshape( d, ker, p );
+			for( int i = 0; i < npoints; i++ ) {
+				odd_isogeny( &S1, d, ker, &(pts[i]), p );
+			}
+			odd_iso_curve( &F1, d, ker, &E, p );
+		}
+		double t1 = bench_time();
+		for( int k = 0; k < it; k++ ) {
+			sqrt_velu V;
+			sqrt_velu_init( &V, l, &G, &E, p );
+			for( int i = 0; i < npoints; i++ ) {
+				sqrt_velu_eval( &S2, &V, &(pts[i]), p );
+			}
+			sqrt_velu_curve( &F2, &V, p );
+			sqrt_velu_clear( &V );
+		}
+		double t2 = bench_time();
+
+		point_normalize_X( &x1, &S1, p );
+		point_normalize_X( &x2, &S2, p );
+		int same = fp2_are_equal( &x1, &x2 ) && same_curve( &F1, &F2, p );
+		int faster = ( t2-t1 < t1-t0 );
+		int picked = sqrt_velu_is_faster( l, npoints );
+		agree += ( picked == faster );
+		velu_time += ( t1-t0 )/it;
+		sqrt_velu_time += ( t2-t1 )/it;
+		velu_mults += velu_cost( l, npoints );
+		sqrt_velu_mults += sqrt_velu_cost( l, npoints );
+		printf("  l = %4d : Velu %.3f ms, sqrt Velu %.3f ms, same result : %d, model picks %s\n",
+			l, ( t1-t0 )*1e3/it, ( t2-t1 )*1e3/it, same, 
+			picked ? "sqrt Velu" : "Velu" );
+
+		for( int i = 0; i < d; i++ ) {
+			point_clear( &(ker[i]) );
+		}
+	}
+
+	fp2 a, b;
+	mpz_set_ui( m, 12345 );
+	fp2_init( &a, m, m, p );
+	fp2_init( &b, m, m, p );
+	// b has full size after the first multiplications.
+	double t0 = bench_time();
+	for( int k = 0; k < 100*iterations; k++ ) {
+		fp2_mult( &b, &a, &b, p );
+	}
+	double t1 = bench_time();
+	for( int k = 0; k < 10*iterations; k++ ) {
+		fp2_multinv( &b, &b, p );
+	}
+	double t2 = bench_time();
+	printf("  model agrees with the timings for %d of %d degrees\n", agree, count );
+	printf("  fp2_multinv : %.1f fp2_mult (INV_COST)\n", 
+		( ( t2-t1 )/10 ) / ( t1-t0 ) * 100 );
+	printf("  sqrt Velu / Velu time per counted multiplication : %.2f (SQRT_VELU_WEIGHT)\n",
+		( sqrt_velu_time/sqrt_velu_mults ) / ( velu_time/velu_mults ) );
+
+	fp2_clear( &a );
+	fp2_clear( &b );
+	fp2_clear( &x1 );
+	fp2_clear( &x2 );
+	for( int i = 0; i < npoints; i++ ) {
+		point_clear( &(pts[i]) );
+	}
+	point_clear( &G );
+	point_clear( &P );
+	point_clear( &S1 );
+	point_clear( &S2 );
+	curve_clear( &E );
+	curve_clear( &F1 );
+	curve_clear( &F2 );
+	mpz_clears( p, m, NULL );
+}
+
+/* --------------------------------------------------------
+                    FIXED BASE LADDER
+----------------------------------------------------------*/
+
+void bench_fixed_base( parameters *param, int iterations ) {
+	/* Compares, for both sides, the kernel point of key generation
+	given by Ladder3pt_without_conversion and by Ladder3pt_table.
+	*/
+	curve E;
+	curve_init_none( &E );
+	curve_from_alpha( &E, &(param->alpha), param->p );
+	curve_normalize( &E, &E, param->p );
+
+	mpz_t s, q;
+	mpz_inits( s, q, NULL );
+	gmp_randstate_t state;
+	gmp_randinit_default( state );
+
+	point R1, R2;
+	point_init_none( &R1 );
+	point_init_none( &R2 );
+	fp2 x1, x2;
+	fp2_init_none( &x1 );
+	fp2_init_none( &x2 );
+
+	for( int side = 0; side < 2; side++ ) {
+		int l = ( side == 0 ) ? param->pA : param->pB;
+		int e = ( side == 0 ) ? param->eA : param->eB;
+		fp2 *xP = ( side == 0 ) ? &(param->xPA) : &(param->xPB);
+		fp2 *xQ = ( side == 0 ) ? &(param->xQA) : &(param->xQB);
+		fp2 *xR = ( side == 0 ) ? &(param->xRA) : &(param->xRB);
+		fp2 *table = ( side == 0 ) ? param->tableA : param->tableB;
+		int n = ( side == 0 ) ? param->tableA_len : param->tableB_len;
+
+		mpz_ui_pow_ui( q, l, e );
+		mpz_urandomm( s, state, q );
+
+		double t0 = bench_time();
+		for( int i = 0; i < iterations; i++ ) {
+			Ladder3pt_without_conversion( &R1, s, xP, xQ, xR, &E, param->p );
+		}
+		double t1 = bench_time();
+		for( int i = 0; i < iterations; i++ ) {
+			Ladder3pt_table( &R2, s, xP, n, table, xR, param->p );
+		}
+		double t2 = bench_time();
+
+		point_normalize_X( &x1, &R1, param->p );
+		point_normalize_X( &x2, &R2, param->p );
+		printf("Ladder3pt for %d^%d, %d iterations :\n", l, e, iterations );
+		printf("  ladder : %.3f ms\n", ( t1-t0 )*1e3/iterations );
+		printf("  fixed base table : %.3f ms\n", ( t2-t1 )*1e3/iterations );
+		printf("  same point : %d\n", fp2_are_equal( &x1, &x2 ) );
+	}
+
+	fp2_clear( &x1 );
+	fp2_clear( &x2 );
+	point_clear( &R1 );
+	point_clear( &R2 );
+	gmp_randclear( state );
+	mpz_clears( s, q, NULL );
+	curve_clear( &E );
+}
+
+/* --------------------------------------------------------
+                    EXTENDED PUBLIC KEYS
+----------------------------------------------------------*/
+
+static void bench_isoex( fp2 *j, pk *PK, sk *SK, parameters *param ) {
+	/* Key exchange of the side A, with the public key PK of the side B.
+	*/
+	if( param->pA == 2 ) {
+		isoex_two( j, SK, PK, param );
+	}
+	else {
+		isoex_Alice( j, PK, SK, param );
+	}
+}
+
+void bench_extended_pk( parameters *param, int iterations ) {
+	/* Compares the key exchange of the side A with a public key, an 
+	extended public key, and an extended public key with validation.
+	*/
+	int extended = param->extended_pk, validate = param->validate_pk;
+	sk SKA, SKB;
+	sk_generate( &SKB, param->pB, param->eB, NULL );
+	sk_generate( &SKA, param->pA, param->eA, NULL );
+	pk PK;
+	pk_init_none( &PK );
+	set_extended_pk( param, 1, 0 );
+	if( param->pA == 2 ) {
+		isogen_three( &PK, &SKB, param );
+	}
+	else {
+		isogen_Bob( &PK, &SKB, param );
+	}
+
+	fp2 j[3];
+	double t[4];
+	const char *name[3] = { "public key", "extended", "extended, validated" };
+	t[0] = bench_time();
+	for( int k = 0; k < 3; k++ ) {
+		fp2_init_none( &(j[k]) );
+		PK.extended = ( k > 0 );
+		set_extended_pk( param, 1, k == 2 );
+		for( int n = 0; n < iterations; n++ ) {
+			bench_isoex( &(j[k]), &PK, &SKA, param );
+		}
+		t[k+1] = bench_time();
+	}
+
+	printf("Key exchange, %d iterations :\n", iterations );
+	for( int k = 0; k < 3; k++ ) {
+		printf("  %s : %.3f ms\n", name[k], ( t[k+1]-t[k] )*1e3/iterations );
+	}
+	printf("  same j : %d\n", fp2_are_equal( &(j[0]), &(j[1]) ) 
+		&& fp2_are_equal( &(j[0]), &(j[2]) ) );
+
+	set_extended_pk( param, extended, validate );
+	for( int k = 0; k < 3; k++ ) {
+		fp2_clear( &(j[k]) );
+	}
+	pk_clear( &PK );
+	sk_clear( &SKA );
+	sk_clear( &SKB );
+}
+
+/* --------------------------------------------------------
+                    KEM
+----------------------------------------------------------*/
+
+void bench_kem( parameters *param, int iterations ) {
+	/* Measures the throughput of the KEM : key generation, encapsulation
+	and decapsulation, which re-encrypts and so costs one key generation
+	and one key exchange on each side.
+	*/
+	pk PK;
+	pk_init_none( &PK );
+	kem_sk SK;
+	kem_sk_init_none( &SK );
+	kem_ct C;
+	kem_ct_init_none( &C );
+	unsigned char K1[KEM_BYTES], K2[KEM_BYTES];
+	int same = 1;
+
+	double t0 = bench_time();
+	kem_keygen( &PK, &SK, param );
+	double t1 = bench_time();
+	for( int i = 0; i < iterations; i++ ) {
+		kem_encaps( K1, &C, &PK, param );
+	}
+	double t2 = bench_time();
+	for( int i = 0; i < iterations; i++ ) {
+		kem_decaps( K2, &C, &SK, param );
+	}
+	double t3 = bench_time();
+	same = ( memcmp( K1, K2, KEM_BYTES ) == 0 );
+
+	// A modified ciphertext has to be rejected.
+	C.c1[0] ^= 1;
+	kem_decaps( K2, &C, &SK, param );
+	int rejected = ( memcmp( K1, K2, KEM_BYTES ) != 0 );
+
+	printf("KEM %d/%d, p of %zu bits, %d iterations :\n", param->pA, param->pB,
+		mpz_sizeinbase( param->p, 2 ), iterations );
+	printf("  keygen : %.3f ms\n", ( t1-t0 )*1e3 );
+	printf("  encaps : %.3f ms, %.1f encaps/s\n", 
+		( t2-t1 )*1e3/iterations, iterations/( t2-t1 ) );
+	printf("  decaps : %.3f ms, %.1f decaps/s\n", 
+		( t3-t2 )*1e3/iterations, iterations/( t3-t2 ) );
+	printf("  same shared secret : %d, modified ciphertext rejected : %d\n", 
+		same, rejected );
+
+	// The public key and the ciphertext go through their encodings, and
+	// the sides disagree on the extended public keys : the shared secrets
+	// must not depend on it.
+	int saved_extended = param->extended_pk;
+	int saved_validate = param->validate_pk;
+	size_t n = pk_bytes( param );
+	unsigned char *buf = malloc( n );
+	pk PK2;
+	pk_init_none( &PK2 );
+	kem_ct C2;
+	kem_ct_init_none( &C2 );
+	for( int ext = 0; ext < 2; ext++ ) {
+		set_extended_pk( param, ext, 0 );
+		kem_keygen( &PK, &SK, param );
+		pk_encode( buf, &PK, param );
+		pk_decode( &PK2, buf, param );
+
+		set_extended_pk( param, !ext, 0 );
+		kem_encaps( K1, &C, &PK2, param );
+		pk_encode( buf, &(C.c0), param );
+		pk_decode( &(C2.c0), buf, param );
+		memcpy( C2.c1, C.c1, KEM_BYTES );
+
+		set_extended_pk( param, ext, 0 );
+		kem_decaps( K2, &C2, &SK, param );
+		printf("  %s key, %s encapsulation, through the encodings, same shared secret : %d\n",
+			ext ? "extended" : "plain", ext ? "plain" : "extended",
+			memcmp( K1, K2, KEM_BYTES ) == 0 );
+	}
+	set_extended_pk( param, saved_extended, saved_validate );
+
+	free( buf );
+	pk_clear( &PK2 );
+	kem_ct_clear( &C2 );
+	kem_ct_clear( &C );
+	kem_sk_clear( &SK );
+	pk_clear( &PK );
+}
+
+/* --------------------------------------------------------
+                    ENCODING
+----------------------------------------------------------*/
+
+static void pk_export( unsigned char *out, pk *PK, parameters *param ) {
+	/* Same as pk_encode, with mpz_export.
+	*/
+	size_t len = fp_bytes( param->p );
+	fp2 *x[4] = { &(PK->x1), &(PK->x2), &(PK->x3), &(PK->beta) };
+	int n = ( param->pA == 2 ) ? 3 : 4;
+	memset( out, 0, 2*n*len );
+	for( int i = 0; i < n; i++ ) {
+		mpz_export( out + 2*i*len, NULL, -1, 1, 0, 0, x[i]->s0 );
+		mpz_export( out + ( 2*i+1 )*len, NULL, -1, 1, 0, 0, x[i]->s1 );
+	}
+}
+
+static void pk_import( pk *PK, const unsigned char *in, parameters *param ) {
+	/* Same as pk_decode, with mpz_import and without the checks.
+	*/
+	size_t len = fp_bytes( param->p );
+	fp2 *x[4] = { &(PK->x1), &(PK->x2), &(PK->x3), &(PK->beta) };
+	int n = ( param->pA == 2 ) ? 3 : 4;
+	for( int i = 0; i < n; i++ ) {
+		mpz_import( x[i]->s0, len, -1, 1, 0, 0, in + 2*i*len );
+		mpz_import( x[i]->s1, len, -1, 1, 0, 0, in + ( 2*i+1 )*len );
+	}
+}
+
+void bench_encoding( parameters *param, int iterations ) {
+	/* Measures the public keys encoded and decoded per second with 
+	pk_encode and pk_decode, against mpz_export and mpz_import, and
+	checks the round trips of a public key, a secret key and a j 
+	invariant.
+	*/
+	mpz_t s;
+	mpz_init( s );
+	sk SK, SK2;
+	sk_generate( &SK, param->pB, param->eB, NULL );
+	sk_init( &SK2, s );
+	pk PK, PK2;
+	pk_init_none( &PK );
+	pk_init_none( &PK2 );
+	if( param->pA == 2 ) {
+		isogen_three( &PK, &SK, param );
+	}
+	else {
+		isogen_Bob( &PK, &SK, param );
+	}
+
+	size_t n = pk_bytes( param );
+	unsigned char *buf = malloc( n );
+	int ok = 1;
+
+	double t0 = bench_time();
+	for( int i = 0; i < iterations; i++ ) {
+		pk_encode( buf, &PK, param );
+	}
+	double t1 = bench_time();
+	for( int i = 0; i < iterations; i++ ) {
+		ok &= pk_decode( &PK2, buf, param );
+	}
+	double t2 = bench_time();
+	for( int i = 0; i < iterations; i++ ) {
+		pk_export( buf, &PK, param );
+	}
+	double t3 = bench_time();
+	for( int i = 0; i < iterations; i++ ) {
+		pk_import( &PK2, buf, param );
+	}
+	double t4 = bench_time();
+
+	ok &= fp2_are_equal( &(PK.x1), &(PK2.x1) ) && fp2_are_equal( &(PK.x2), &(PK2.x2) )
+		&& fp2_are_equal( &(PK.x3), &(PK2.x3) );
+	if( param->pA != 2 ) {
+		ok &= fp2_are_equal( &(PK.beta), &(PK2.beta) );
+	}
+
+	// Secret key and shared secret.
+	size_t m = sk_bytes( param->pB, param->eB );
+	unsigned char *sbuf = malloc( m );
+	mpz_ui_pow_ui( s, param->pB, param->eB );
+	mpz_sub_ui( SK.secret, s, 1 );
+	sk_encode( sbuf, &SK, param->pB, param->eB );
+	ok &= sk_decode( &SK2, sbuf, param->pB, param->eB );
+	ok &= ( mpz_cmp( SK.secret, SK2.secret ) == 0 );
+	unsigned char *jbuf = malloc( 2*fp_bytes( param->p ) );
+	fp2_encode( jbuf, &(PK.x1), param->p );
+	ok &= fp2_decode( &(PK2.x2), jbuf, param->p );
+	ok &= fp2_are_equal( &(PK.x1), &(PK2.x2) );
+
+	printf("Public keys of %zu bytes, secret keys of %zu bytes, %d iterations :\n", 
+		n, m, iterations );
+	printf("  pk_encode : %.0f keys/s\n", iterations/( t1-t0 ) );
+	printf("  pk_decode : %.0f keys/s\n", iterations/( t2-t1 ) );
+	printf("  mpz_export : %.0f keys/s\n", iterations/( t3-t2 ) );
+	printf("  mpz_import : %.0f keys/s\n", iterations/( t4-t3 ) );
+	printf("  round trips : %d\n", ok );
+
+	free( buf );
+	free( sbuf );
+	free( jbuf );
+	pk_clear( &PK );
+	pk_clear( &PK2 );
+	sk_clear( &SK );
+	sk_clear( &SK2 );
+	mpz_clear( s );
+}
+
+void bench_compression( parameters *param, int iterations ) {
+	/* Compares the time to compress and decompress a public key with
+	its key generation, for both sides, and checks that the exchange
+	with the decompressed keys gives the same j invariant.
+	*/
+	sk SKA, SKB;
+	sk_generate( &SKA, param->pA, param->eA, NULL );
+	sk_generate( &SKB, param->pB, param->eB, NULL );
+	pk PKA, PKB, PKA2, PKB2;
+	pk_init_none( &PKA );
+	pk_init_none( &PKB );
+	pk_init_none( &PKA2 );
+	pk_init_none( &PKB2 );
+	pk_compressed CA, CB;
+	pkc_init_none( &CA );
+	pkc_init_none( &CB );
+
+	// PKA carries the images of the B torsion, PKB those of the A torsion.
+	double t0 = bench_time();
+	for( int i = 0; i < iterations; i++ ) {
+		if( param->pA == 2 ) {
+			isogen_two( &PKA, &SKA, param );
+			isogen_three( &PKB, &SKB, param );
+		}
+		else {
+			isogen_Alice( &PKA, &SKA, param );
+			isogen_Bob( &PKB, &SKB, param );
+		}
+	}
+	double t1 = bench_time();
+	int ok = 1;
+	for( int i = 0; i < iterations; i++ ) {
+		ok &= pk_compress( &CA, &PKA, param->pB, param->eB, param );
+		ok &= pk_compress( &CB, &PKB, param->pA, param->eA, param );
+	}
+	double t2 = bench_time();
+	for( int i = 0; i < iterations; i++ ) {
+		ok &= pk_decompress( &PKA2, &CA, param->pB, param->eB, param );
+		ok &= pk_decompress( &PKB2, &CB, param->pA, param->eA, param );
+	}
+	double t3 = bench_time();
+
+	fp2 jA, jB;
+	fp2_init_none( &jA );
+	fp2_init_none( &jB );
+	if( param->pA == 2 ) {
+		isoex_two( &jA, &SKA, &PKB2, param );
+		isoex_three( &jB, &SKB, &PKA2, param );
+	}
+	else {
+		isoex_Alice( &jA, &PKB2, &SKA, param );
+		isoex_Bob( &jB, &PKA2, &SKB, param );
+	}
+	ok &= fp2_are_equal( &jA, &jB );
+
+	printf("Compressed public keys, %d iterations ( both sides ) :\n", iterations );
+	printf("  sizes : %zu -> %zu bytes ( A ), %zu -> %zu bytes ( B )\n", 
+		pk_bytes( param ), pkc_bytes( param->pB, param->eB, param ),
+		pk_bytes( param ), pkc_bytes( param->pA, param->eA, param ) );
+	printf("  key generation : %f ms\n", 1000*( t1-t0 )/iterations );
+	printf("  compression : %f ms\n", 1000*( t2-t1 )/iterations );
+	printf("  decompression : %f ms\n", 1000*( t3-t2 )/iterations );
+	printf("  same j invariant : %d\n", ok );
+
+	fp2_clear( &jA );
+	fp2_clear( &jB );
+	pkc_clear( &CA );
+	pkc_clear( &CB );
+	pk_clear( &PKA );
+	pk_clear( &PKB );
+	pk_clear( &PKA2 );
+	pk_clear( &PKB2 );
+	sk_clear( &SKA );
+	sk_clear( &SKB );
+}
+
+/* --------------------------------------------------------
+                    SECRET KEYS
+----------------------------------------------------------*/
+
+void bench_sk_generate( parameters *param, int iterations ) {
+	/* Measures the secret keys generated per second for both sides, 
+	from getrandom and from the buffered generator.
+	*/
+	drbg D;
+	drbg_init( &D );
+	mpz_t s, q;
+	mpz_inits( s, q, NULL );
+
+	printf("Secret keys, %d iterations :\n", iterations );
+	for( int side = 0; side < 2; side++ ) {
+		int l = ( side == 0 ) ? param->pA : param->pB;
+		int e = ( side == 0 ) ? param->eA : param->eB;
+		int ok = 1;
+		mpz_ui_pow_ui( q, l, e );
+
+		double t0 = bench_time();
+		for( int i = 0; i < iterations; i++ ) {
+			random_secret( s, l, e, NULL );
+			ok &= ( mpz_cmp( s, q ) < 0 );
+		}
+		double t1 = bench_time();
+		for( int i = 0; i < iterations; i++ ) {
+			random_secret( s, l, e, &D );
+			ok &= ( mpz_cmp( s, q ) < 0 );
+		}
+		double t2 = bench_time();
+		printf("  mod %d^%d, getrandom : %.0f keys/s, drbg : %.0f keys/s, in range : %d\n",
+			l, e, iterations/( t1-t0 ), iterations/( t2-t1 ), ok );
+	}
+
+	drbg_clear( &D );
+	mpz_clears( s, q, NULL );
+}
+
+/* --------------------------------------------------------
+                    BATCH KEY GENERATION
+----------------------------------------------------------*/
+
+static int same_pk( pk *P, pk *Q, int general ) {
+	/* Returns 1 if the abscissas of P and Q are equal, and their 
+	coefficients if they are extended.
+	*/
+	int same = fp2_are_equal( &(P->x1), &(Q->x1) )
+		&& fp2_are_equal( &(P->x2), &(Q->x2) )
+		&& fp2_are_equal( &(P->x3), &(Q->x3) )
+		&& P->extended == Q->extended;
+	if( general ) {
+		same = same && fp2_are_equal( &(P->beta), &(Q->beta) );
+	}
+	if( P->extended ) {
+		same = same && fp2_are_equal( &(P->A), &(Q->A) );
+	}
+	return same;
+}
+
+void bench_batch( parameters *param, int n, int threads ) {
+	/* Measures the public keys generated per second for both sides,
+	with one isogen call per key, and with isogen_batch on 1, 2, 4...
+	up to threads threads. The keys of the batches are compared with
+	the ones of the single calls.
+	*/
+	int general = ( param->pA != 2 );
+	pool *saved = param->W;
+	set_pool( param, NULL );
+	pk PK[n], PK1[n];
+	sk SK[n];
+
+	printf("Batch key generation, %d keys :\n", n );
+	for( int side = 0; side < 2; side++ ) {
+		int l = ( side == 0 ) ? param->pA : param->pB;
+		int e = ( side == 0 ) ? param->eA : param->eB;
+		for( int i = 0; i < n; i++ ) {
+			pk_init_none( &(PK[i]) );
+			pk_init_none( &(PK1[i]) );
+			sk_generate( &(SK[i]), l, e, NULL );
+		}
+
+		double t0 = bench_time();
+		for( int i = 0; i < n; i++ ) {
+			if( !general && side == 0 ) {
+				isogen_two( &(PK1[i]), &(SK[i]), param );
+			}
+			else if( !general ) {
+				isogen_three( &(PK1[i]), &(SK[i]), param );
+			}
+			else if( side == 0 ) {
+				isogen_Alice( &(PK1[i]), &(SK[i]), param );
+			}
+			else {
+				isogen_Bob( &(PK1[i]), &(SK[i]), param );
+			}
+		}
+		double t1 = bench_time();
+		printf("  side %d^%d, single : %.1f keys/s\n", l, e, n/( t1-t0 ) );
+
+		for( int t = 1; t <= threads; t *= 2 ) {
+			pool *W = ( t == 1 ) ? NULL : pool_new( t );
+			t0 = bench_time();
+			isogen_batch( n, PK, SK, side, param, W );
+			t1 = bench_time();
+			int ok = 1;
+			for( int i = 0; i < n; i++ ) {
+				ok &= same_pk( &(PK[i]), &(PK1[i]), general );
+			}
+			printf("  side %d^%d, batch, %d thread(s) : %.1f keys/s, same keys : %d\n", 
+				l, e, t, n/( t1-t0 ), ok );
+			pool_free( W );
+		}
+
+		for( int i = 0; i < n; i++ ) {
+			pk_clear( &(PK[i]) );
+			pk_clear( &(PK1[i]) );
+			sk_clear( &(SK[i]) );
+		}
+	}
+	set_pool( param, saved );
+}
+
+/* --------------------------------------------------------
+                    CONTEXTS
+----------------------------------------------------------*/
+
+typedef struct bench_ctx_data {
+	parameters *param;
+	int iterations;
+	int failed[64];
+} bench_ctx_data;
+
+static void bench_ctx_job( void *arg, int t ) {
+	/* Runs iterations key exchanges on a ctx of its own, and counts the
+	failed ones in failed[t].
+	*/
+	bench_ctx_data *B = arg;
+	ctx C;
+	ctx_init( &C, B->param );
+	pk PKA, PKB;
+	sk SKA, SKB;
+	fp2 jA, jB;
+	pk_init_none( &PKA );
+	pk_init_none( &PKB );
+	fp2_init_none( &jA );
+	fp2_init_none( &jB );
+	B->failed[t] = 0;
+	for( int n = 0; n < B->iterations; n++ ) {
+		ctx_keygen( &C, &PKA, &SKA, 0 );
+		ctx_keygen( &C, &PKB, &SKB, 1 );
+		ctx_isoex( &C, &jA, &SKA, &PKB, 0 );
+		ctx_isoex( &C, &jB, &SKB, &PKA, 1 );
+		B->failed[t] += !fp2_are_equal( &jA, &jB );
+		sk_clear( &SKA );
+		sk_clear( &SKB );
+	}
+	pk_clear( &PKA );
+	pk_clear( &PKB );
+	fp2_clear( &jA );
+	fp2_clear( &jB );
+	ctx_clear( &C );
+}
+
+void bench_ctx( parameters *param, int threads, int iterations ) {
+	/* Measures the key exchanges per second with 1, 2, 4... up to threads
+	threads, each running iterations exchanges on its own ctx, param being
+	shared by all of them.
+	*/
+	bench_ctx_data B;
+	B.param = param;
+	B.iterations = iterations;
+	if( threads > 64 ) {
+		threads = 64;
+	}
+
+	printf("Contexts, %d exchanges per thread :\n", iterations );
+	for( int t = 1; t <= threads; t *= 2 ) {
+		pool *W = ( t == 1 ) ? NULL : pool_new( t );
+		double t0 = bench_time();
+		pool_run( W, t, bench_ctx_job, &B );
+		double t1 = bench_time();
+		int failed = 0;
+		for( int i = 0; i < t; i++ ) {
+			failed += B.failed[i];
+		}
+		printf("  %d thread(s) : %.1f exchanges/s, failed : %d\n", 
+			t, t*iterations/( t1-t0 ), failed );
+		pool_free( W );
+	}
+}
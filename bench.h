@@ -0,0 +1,70 @@
+/*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*
+*
+* Contains the declarations of the benchmarks of bench.c,
+* linked with Main only, not with the library.
+*
+*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*/
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include "Header.h"
+
+/* ---------------------------------------------------------
+        				BENCHMARK
+-----------------------------------------------------------*/
+
+double bench_time( void );
+	/* Returns a monotonic time in seconds.
+	*/
+void bench_codomain( parameters *param, int iterations );
+	/* Compares the codomain computation with and without evaluating
+	the two torsion point, for one isogeny of each odd degree pA, pB.
+	*/
+void bench_threads( parameters *param, int threads, int iterations );
+	/* Compares the key generation times with and without a pool
+	of threads threads.
+	*/
+void bench_exchange( parameters *param, int iterations );
+	/* Compares the isogeny chains of the 2/3 key exchange with and
+	without the evaluation of dummy points.
+	*/
+void bench_extended_pk( parameters *param, int iterations );
+	/* Compares the key exchange with a public key, an extended public 
+	key, and an extended public key with validation.
+	*/
+void bench_sqrt_velu( parameters *param, int npoints, int iterations );
+	/* Compares the linear and the square-root Velu formulas for odd
+	degrees up to 1511, and measures the costs used by sqrt_velu_is_faster.
+	*/
+void bench_fixed_base( parameters *param, int iterations );
+	/* Compares the kernel point of key generation given by the ladder
+	and by the tables of set_points, for both sides.
+	*/
+void bench_encoding( parameters *param, int iterations );
+	/* Measures the public keys encoded and decoded per second, and 
+	checks the round trips of the encodings.
+	*/
+void bench_kem( parameters *param, int iterations );
+	/* Measures the key generation, and the encapsulations and 
+	decapsulations per second of the KEM.
+	*/
+void bench_compression( parameters *param, int iterations );
+	/* Compares the compression and decompression of the public keys
+	with their key generation, and checks the exchange.
+	*/
+void bench_sk_generate( parameters *param, int iterations );
+	/* Measures the secret keys generated per second, from getrandom and
+	from the buffered generator.
+	*/
+void bench_batch( parameters *param, int n, int threads );
+	/* Measures the public keys generated per second by isogen_batch on
+	batches of n keys, with 1, 2, 4... up to threads threads, against 
+	one isogen call per key, and checks the keys.
+	*/
+void bench_ctx( parameters *param, int threads, int iterations );
+	/* Measures the key exchanges per second with 1, 2, 4... up to threads
+	threads sharing param, each with its own ctx, and checks them.
+	*/
+
+#endif
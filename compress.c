@@ -0,0 +1,1105 @@
+/*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*
+*
+* Contains the compression of public keys, as in SIKE : the
+* images of P and Q are written as combinations of a torsion
+* basis of the image curve, deterministically generated from
+* its coefficient A. The scalars are discrete logarithms of
+* reduced Tate pairings, solved with Pohlig-Hellman.
+*
+*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <gmp.h>
+#include "Header.h"
+
+#define BASIS_TRIES 1000 // abscissas tried to find a torsion basis.
+
+typedef struct affine {
+	/* Point ( x, y ) of y^2 = x^3 + Ax^2 + x.
+	*/
+	fp2 x;
+	fp2 y;
+} affine;
+
+static void affine_init( affine *P ) {
+	fp2_init_none( &(P->x) );
+	fp2_init_none( &(P->y) );
+}
+
+static void affine_clear( affine *P ) {
+	fp2_clear( &(P->x) );
+	fp2_clear( &(P->y) );
+}
+
+static void fp2_conj( fp2 *res, fp2 *a, mpz_t p ) {
+	/* Sets res as the conjugate of a, ie a^p. For a of norm 1, it is
+	the inverse of a.
+	*/
+	mpz_set( res->s0, a->s0 );
+	mpz_neg( res->s1, a->s1 );
+	mpz_mod( res->s1, res->s1, p );
+}
+
+static void fp2_sqr( fp2 *res, fp2 *a, mpz_t p ) {
+	/* Sets res as a^2 = ( a0+a1 )( a0-a1 ) + 2a0a1 i, with two 
+	multiplications of Fp.
+	*/
+	mpz_t t, u;
+	mpz_inits( t, u, NULL );
+	mpz_add( t, a->s0, a->s1 );
+	mpz_sub( u, a->s0, a->s1 );
+	mpz_mul( t, t, u );
+	mpz_mul( u, a->s0, a->s1 );
+	mpz_mul_2exp( u, u, 1 );
+	mpz_mod( res->s0, t, p );
+	mpz_mod( res->s1, u, p );
+	mpz_clears( t, u, NULL );
+}
+
+static void curve_rhs( fp2 *r, fp2 *x, fp2 *A, mpz_t p ) {
+	/* Sets r as x^3 + Ax^2 + x.
+	*/
+	fp2 t;
+	fp2_init_none( &t );
+	fp2_add( &t, x, A, p );
+	fp2_mult( &t, &t, x, p );
+	mpz_add_ui( t.s0, t.s0, 1 );
+	fp2_mult( r, &t, x, p );
+	fp2_clear( &t );
+}
+
+static int affine_lift( affine *P, fp2 *x, fp2 *A, mpz_t p ) {
+	/* Sets P as ( x, y ), with y the square root given by fp2_sqrt, and
+	returns 1 if x is the abscissa of a point of the curve, 0 otherwise.
+	*/
+	fp2 r;
+	fp2_init_none( &r );
+	curve_rhs( &r, x, A, p );
+	fp2_set( &(P->x), x );
+	int square = fp2_sqrt( &(P->y), &r, p );
+	fp2_clear( &r );
+	return square;
+}
+
+static void affine_diff_x( fp2 *x, affine *P, affine *Q, fp2 *A, mpz_t p ) {
+	/* Sets x as the abscissa of P-Q, with P != +-Q :
+	lambda = ( yP + yQ )/( xP - xQ ), x = lambda^2 - A - xP - xQ.
+	*/
+	fp2 l, t;
+	fp2_init_none( &l );
+	fp2_init_none( &t );
+	fp2_sub( &t, &(P->x), &(Q->x), p );
+	fp2_multinv( &t, &t, p );
+	fp2_add( &l, &(P->y), &(Q->y), p );
+	fp2_mult( &l, &l, &t, p );
+	fp2_mult( &l, &l, &l, p );
+	fp2_sub( &l, &l, A, p );
+	fp2_sub( &l, &l, &(P->x), p );
+	fp2_sub( x, &l, &(Q->x), p );
+	fp2_clear( &l );
+	fp2_clear( &t );
+}
+
+static int is_square( fp2 *a, mpz_t p ) {
+	/* Returns 1 if a is a non zero square of Fp2, ie if its norm 
+	s0^2 + s1^2 is a square of Fp, 0 otherwise. Much cheaper than fp2_sqrt.
+	*/
+	mpz_t t;
+	mpz_init( t );
+	mpz_mul( t, a->s0, a->s0 );
+	mpz_addmul( t, a->s1, a->s1 );
+	mpz_mod( t, t, p );
+	int square = ( mpz_jacobi( t, p ) == 1 );
+	mpz_clear( t );
+	return square;
+}
+
+static int same_x( point *P, point *Q, mpz_t p ) {
+	/* Returns 1 if P and Q have the same abscissa, by cross multiplication.
+	*/
+	fp2 a, b;
+	fp2_init_none( &a );
+	fp2_init_none( &b );
+	fp2_mult( &a, &(P->X), &(Q->Z), p );
+	fp2_mult( &b, &(Q->X), &(P->Z), p );
+	int same = fp2_are_equal( &a, &b );
+	fp2_clear( &a );
+	fp2_clear( &b );
+	return same;
+}
+
+/* --------------------------------------------------------
+ 					CYCLOTOMIC SUBGROUP
+----------------------------------------------------------*/
+
+#define CYCLO_WINDOW 4 // width of the signed digits of cyclo_pow.
+
+typedef struct cyclo_exp {
+	/* Digits of an exponent in width CYCLO_WINDOW NAF, little endian : 
+	each digit is 0 or odd, of absolute value less than 2^(CYCLO_WINDOW-1).
+	*/
+	int len;
+	signed char *d;
+} cyclo_exp;
+
+static void cyclo_exp_new( cyclo_exp *E, mpz_t e ) {
+	/* Sets E as the digits of e >= 0.
+	*/
+	mpz_t k;
+	mpz_init_set( k, e );
+	E->d = malloc( ( mpz_sizeinbase( e, 2 ) + 1 )*sizeof( signed char ) );
+	E->len = 0;
+	while( mpz_sgn( k ) > 0 ) {
+		int d = 0;
+		if( mpz_odd_p( k ) ) {
+			d = mpz_fdiv_ui( k, 1 << CYCLO_WINDOW );
+			if( d >= 1 << ( CYCLO_WINDOW-1 ) ) {
+				d -= 1 << CYCLO_WINDOW;
+				mpz_add_ui( k, k, -d );
+			}
+			else {
+				mpz_sub_ui( k, k, d );
+			}
+		}
+		E->d[E->len++] = d;
+		mpz_tdiv_q_2exp( k, k, 1 );
+	}
+	mpz_clear( k );
+}
+
+static void cyclo_exp_clear( cyclo_exp *E ) {
+	free( E->d );
+}
+
+static void cyclo_sqr( fp2 *res, fp2 *a, mpz_t p ) {
+	/* Sets res as a^2, for a of norm a0^2 + a1^2 = 1, with two squarings
+	of Fp : a^2 = ( 2a0^2 - 1 ) + ( ( a0+a1 )^2 - 1 )i.
+	*/
+	mpz_t t;
+	mpz_init( t );
+	mpz_add( t, a->s0, a->s1 );
+	mpz_mul( t, t, t );
+	mpz_sub_ui( t, t, 1 );
+	mpz_mul( res->s0, a->s0, a->s0 );
+	mpz_mul_2exp( res->s0, res->s0, 1 );
+	mpz_sub_ui( res->s0, res->s0, 1 );
+	mpz_mod( res->s0, res->s0, p );
+	mpz_mod( res->s1, t, p );
+	mpz_clear( t );
+}
+
+static void cyclo_pow( fp2 *res, fp2 *a, cyclo_exp *E, mpz_t p ) {
+	/* Sets res as a^e, where E holds the digits of e and a has norm 1 :
+	the negative digits use the conjugates of the odd powers of a, which
+	are their inverses.
+	*/
+	int m = 1 << ( CYCLO_WINDOW-2 );
+	fp2 pw[m], acc, t;
+	fp2_init_none( &acc );
+	fp2_init_none( &t );
+	// pw[j] = a^( 2j+1 ).
+	cyclo_sqr( &t, a, p );
+	for( int j = 0; j < m; j++ ) {
+		fp2_init_none( &(pw[j]) );
+		if( j == 0 ) {
+			fp2_set( &(pw[j]), a );
+		}
+		else {
+			fp2_mult( &(pw[j]), &(pw[j-1]), &t, p );
+		}
+	}
+
+	mpz_set_ui( acc.s0, 1 );
+	for( int i = E->len-1; i >= 0; i-- ) {
+		cyclo_sqr( &acc, &acc, p );
+		int d = E->d[i];
+		if( d > 0 ) {
+			fp2_mult( &acc, &acc, &(pw[d/2]), p );
+		}
+		else if( d < 0 ) {
+			fp2_conj( &t, &(pw[-d/2]), p );
+			fp2_mult( &acc, &acc, &t, p );
+		}
+	}
+	fp2_set( res, &acc );
+
+	for( int j = 0; j < m; j++ ) {
+		fp2_clear( &(pw[j]) );
+	}
+	fp2_clear( &acc );
+	fp2_clear( &t );
+}
+
+static void cyclo_pow_ui( fp2 *res, fp2 *a, unsigned long e, mpz_t p ) {
+	/* Sets res as a^e, for a small e > 0 and a of norm 1.
+	*/
+	fp2 acc;
+	fp2_init_none( &acc );
+	fp2_set( &acc, a );
+	int top = 0;
+	while( ( e >> top ) > 1 ) {
+		top++;
+	}
+	for( int i = top-1; i >= 0; i-- ) {
+		cyclo_sqr( &acc, &acc, p );
+		if( ( e >> i ) & 1 ) {
+			fp2_mult( &acc, &acc, a, p );
+		}
+	}
+	fp2_set( res, &acc );
+	fp2_clear( &acc );
+}
+
+/* --------------------------------------------------------
+ 					TORSION BASIS
+----------------------------------------------------------*/
+
+static int torsion_basis( affine R[2], fp2 *A, int l, int e, mpz_t p ) {
+	/* Sets R[0] and R[1] as a basis of E[l^e], where E : y^2 = x^3 + Ax^2 + x.
+	The points are the first [(p+1)/l^e]( 1+ki, y ) of order l^e, for
+	k = 1, 2, ..., the second one being independent from the first one,
+	and y is the square root given by fp2_sqrt. The basis thus only
+	depends on A. Returns 1 if a basis is found, 0 otherwise.
+	*/
+	mpz_t h, m, n, j;
+	mpz_inits( h, m, n, j, NULL );
+	mpz_ui_pow_ui( n, l, e );
+	mpz_ui_pow_ui( m, l, e-1 );
+	mpz_add_ui( h, p, 1 );
+	int found = 0;
+	if( !mpz_divisible_p( h, n ) ) {
+		mpz_clears( h, m, n, j, NULL );
+		return 0;
+	}
+	mpz_divexact( h, h, n );
+
+	curve F, G;
+	curve_init_none( &F ); // ( A+2 : 4 ), for the doublings.
+	fp2_set( &(F.A), A );
+	mpz_add_ui( F.A.s0, F.A.s0, 2 );
+	mpz_set_ui( F.C.s0, 4 );
+	curve_init_none( &G ); // ( A+2 : A-2 ), for the triplings.
+	fp2_set( &(G.A), &(F.A) );
+	fp2_set( &(G.C), A );
+	mpz_sub_ui( G.C.s0, G.C.s0, 2 );
+	mpz_mod( G.C.s0, G.C.s0, p );
+
+	fp2 x, y;
+	fp2_init_none( &x );
+	fp2_init_none( &y );
+	point S, T, U, U0, V;
+	point_init_none( &S );
+	point_init_none( &T );
+	point_init_none( &U );
+	point_init_none( &U0 );
+	point_init_none( &V );
+
+	for( int k = 1; k <= BASIS_TRIES && found < 2; k++ ) {
+		mpz_set_ui( x.s0, 1 );
+		mpz_set_ui( x.s1, k );
+		curve_rhs( &y, &x, A, p );
+		if( !is_square( &y, p ) ) {
+			continue;
+		}
+		fp2_set( &(S.X), &x );
+		mpz_set_ui( S.Z.s0, 1 );
+		mpz_set_ui( S.Z.s1, 0 );
+		Ladder( &T, &S, &F, h, p );
+		if( l == 2 ) {
+			xDBLe( &U, &T, &F, p, e-1 );
+		}
+		else if( l == 3 ) {
+			xTPLe( &U, &T, &G, p, e-1 );
+		}
+		else {
+			Ladder( &U, &T, &F, m, p );
+		}
+		if( fp2_is_zero( &(U.Z), p ) ) {
+			continue; // T has order less than l^e.
+		}
+		if( found == 1 ) {
+			// U has to be out of the subgroup of order l spanned by U0.
+			int dependent = 0;
+			for( mpz_set_ui( j, 1 ); mpz_cmp_ui( j, l/2 ) <= 0 && !dependent; 
+				mpz_add_ui( j, j, 1 ) ) {
+				Ladder( &V, &U0, &F, j, p );
+				dependent = same_x( &U, &V, p );
+			}
+			if( dependent ) {
+				continue;
+			}
+		}
+		point_normalize_X( &x, &T, p );
+		if( !affine_lift( &(R[found]), &x, A, p ) ) {
+			break; // E is not the curve with (p+1)^2 points.
+		}
+		point_set( &U0, &U );
+		found++;
+	}
+
+	fp2_clear( &x );
+	fp2_clear( &y );
+	point_clear( &S );
+	point_clear( &T );
+	point_clear( &U );
+	point_clear( &U0 );
+	point_clear( &V );
+	curve_clear( &F );
+	curve_clear( &G );
+	mpz_clears( h, m, n, j, NULL );
+	return found == 2;
+}
+
+int torsion_basis_x( fp2 *xP, fp2 *xQ, fp2 *xR, fp2 *A, int l, int e, mpz_t p ) {
+	/* Sets xP, xQ and xR as the abscissas of P, Q and P-Q, for the basis
+	P, Q of E[l^e] given by torsion_basis, E : y^2 = x^3 + Ax^2 + x. For 
+	l = 2, Q is chosen above (0,0), so that the kernels P + [s]Q never
+	are, as in SIKE. Returns 1 if a basis is found, 0 otherwise.
+	*/
+	affine R[2];
+	affine_init( &(R[0]) );
+	affine_init( &(R[1]) );
+	point S, T;
+	point_init_none( &S );
+	point_init_none( &T );
+	curve F;
+	curve_init_none( &F ); // ( A+2 : 4 ).
+	fp2_set( &(F.A), A );
+	mpz_add_ui( F.A.s0, F.A.s0, 2 );
+	mpz_set_ui( F.C.s0, 4 );
+
+	int ok = torsion_basis( R, A, l, e, p );
+	if( ok ) {
+		fp2_set( xP, &(R[0].x) );
+		fp2_set( xQ, &(R[1].x) );
+		affine_diff_x( xR, &(R[0]), &(R[1]), A, p );
+	}
+	if( ok && l == 2 ) {
+		// The points of order 2 below R[0] and R[1] are distinct, so one 
+		// of R[0], R[1] and R[0]+R[1] is above (0,0).
+		int above[2];
+		for( int i = 0; i < 2; i++ ) {
+			fp2_set( &(S.X), &(R[i].x) );
+			mpz_set_ui( S.Z.s0, 1 );
+			mpz_set_ui( S.Z.s1, 0 );
+			xDBLe( &T, &S, &F, p, e-1 );
+			above[i] = fp2_is_zero( &(T.X), p );
+		}
+		if( above[0] ) {
+			mpz_swap( xP->s0, xQ->s0 ); // P-Q and Q-P have the same abscissa.
+			mpz_swap( xP->s1, xQ->s1 );
+		}
+		else if( !above[1] ) {
+			// ( R0, R0+R1 ) is a basis, with difference -R1.
+			fp2 zero;
+			fp2_init_none( &zero );
+			fp2_sub( &(R[1].y), &zero, &(R[1].y), p );
+			fp2_clear( &zero );
+			affine_diff_x( xQ, &(R[0]), &(R[1]), A, p );
+			fp2_set( xR, &(R[1].x) );
+		}
+	}
+
+	affine_clear( &(R[0]) );
+	affine_clear( &(R[1]) );
+	point_clear( &S );
+	point_clear( &T );
+	curve_clear( &F );
+	return ok;
+}
+
+/* --------------------------------------------------------
+ 					PAIRINGS
+----------------------------------------------------------*/
+
+#define MILLER_DBL 1 // the step squares the function first.
+#define MILLER_VERTICAL 2 // the line is x - xT, and the step ends in O.
+
+typedef struct miller_table {
+	/* Lines of the Miller loop of f_{n,R}, so that the pairings of R with
+	several points only cost the evaluations.
+	For a step, the line is y - yT - lambda( x - xT ) and the vertical
+	is x - xN, where N is the next point.
+	*/
+	int len;
+	int *type;
+	fp2 *xT;
+	fp2 *yT;
+	fp2 *lambda;
+	fp2 *xN;
+} miller_table;
+
+static void miller_tables_new( int count, miller_table M[count], affine *R[count], 
+	fp2 *A, mpz_t n, mpz_t p ) {
+	/* Computes the lines of the Miller loops of f_{n,R[i]}, where the R[i]
+	have order n. The loops have the same steps, so that the slopes of
+	the count tables are computed with a single inversion at each step.
+	*/
+	int bits = mpz_sizeinbase( n, 2 );
+	fp2 x[count], y[count], t[count], u[count];
+	for( int j = 0; j < count; j++ ) {
+		M[j].len = 0;
+		M[j].type = malloc( 2*bits*sizeof( int ) );
+		M[j].xT = malloc( 2*bits*sizeof( fp2 ) );
+		M[j].yT = malloc( 2*bits*sizeof( fp2 ) );
+		M[j].lambda = malloc( 2*bits*sizeof( fp2 ) );
+		M[j].xN = malloc( 2*bits*sizeof( fp2 ) );
+		fp2_init_none( &(x[j]) );
+		fp2_init_none( &(y[j]) );
+		fp2_init_none( &(t[j]) );
+		fp2_init_none( &(u[j]) );
+		fp2_set( &(x[j]), &(R[j]->x) );
+		fp2_set( &(y[j]), &(R[j]->y) );
+	}
+
+	for( int i = bits-2; i >= 0; i-- ) {
+		for( int add = 0; add < 2; add++ ) {
+			if( add && !mpz_tstbit( n, i ) ) {
+				break;
+			}
+			int k = M[0].len;
+			for( int j = 0; j < count; j++ ) {
+				M[j].len++;
+				M[j].type[k] = add ? 0 : MILLER_DBL;
+				fp2_init_none( &(M[j].xT[k]) );
+				fp2_init_none( &(M[j].yT[k]) );
+				fp2_init_none( &(M[j].lambda[k]) );
+				fp2_init_none( &(M[j].xN[k]) );
+				fp2_set( &(M[j].xT[k]), &(x[j]) );
+				fp2_set( &(M[j].yT[k]), &(y[j]) );
+				if( ( add && fp2_are_equal( &(x[j]), &(R[j]->x) ) )
+					|| ( !add && fp2_is_zero( &(y[j]), p ) ) ) {
+					// T = -R, or T has order 2 : the step ends in O.
+					M[j].type[k] |= MILLER_VERTICAL;
+					mpz_set_ui( u[j].s0, 1 ); // nothing to invert.
+					mpz_set_ui( u[j].s1, 0 );
+				}
+				else if( add ) {
+					// lambda = ( yR - yT )/( xR - xT ).
+					fp2_sub( &(t[j]), &(R[j]->y), &(y[j]), p );
+					fp2_sub( &(u[j]), &(R[j]->x), &(x[j]), p );
+				}
+				else {
+					// lambda = ( 3xT^2 + 2AxT + 1 )/( 2yT ).
+					fp2_add( &(t[j]), &(x[j]), &(x[j]), p );
+					fp2_add( &(t[j]), &(t[j]), &(x[j]), p );
+					fp2_add( &(u[j]), A, A, p );
+					fp2_add( &(t[j]), &(t[j]), &(u[j]), p );
+					fp2_mult( &(t[j]), &(t[j]), &(x[j]), p );
+					mpz_add_ui( t[j].s0, t[j].s0, 1 );
+					fp2_add( &(u[j]), &(y[j]), &(y[j]), p );
+				}
+			}
+			fp2_batch_multinv( count, u, u, p );
+			for( int j = 0; j < count; j++ ) {
+				if( M[j].type[k] & MILLER_VERTICAL ) {
+					continue;
+				}
+				fp2 *l = &(M[j].lambda[k]);
+				fp2_mult( l, &(t[j]), &(u[j]), p );
+				// xN = lambda^2 - A - xT - ( xT or xR ), yN = lambda( xT - xN ) - yT.
+				fp2_mult( &(t[j]), l, l, p );
+				fp2_sub( &(t[j]), &(t[j]), A, p );
+				fp2_sub( &(t[j]), &(t[j]), &(x[j]), p );
+				fp2_sub( &(t[j]), &(t[j]), add ? &(R[j]->x) : &(x[j]), p );
+				fp2_set( &(M[j].xN[k]), &(t[j]) );
+				fp2_sub( &(u[j]), &(x[j]), &(t[j]), p );
+				fp2_mult( &(u[j]), &(u[j]), l, p );
+				fp2_sub( &(y[j]), &(u[j]), &(y[j]), p );
+				fp2_set( &(x[j]), &(t[j]) );
+			}
+		}
+	}
+
+	for( int j = 0; j < count; j++ ) {
+		fp2_clear( &(x[j]) );
+		fp2_clear( &(y[j]) );
+		fp2_clear( &(t[j]) );
+		fp2_clear( &(u[j]) );
+	}
+}
+
+static void miller_table_clear( miller_table *M ) {
+	for( int k = 0; k < M->len; k++ ) {
+		fp2_clear( &(M->xT[k]) );
+		fp2_clear( &(M->yT[k]) );
+		fp2_clear( &(M->lambda[k]) );
+		fp2_clear( &(M->xN[k]) );
+	}
+	free( M->type );
+	free( M->xT );
+	free( M->yT );
+	free( M->lambda );
+	free( M->xN );
+}
+
+static int miller_eval( fp2 *num, fp2 *den, miller_table *M, affine *Q, mpz_t p ) {
+	/* Sets num/den as f_{n,R}( Q ), where M is the table of R, without
+	inversion, and returns 1. Returns 0 if Q is on one of the lines.
+	*/
+	fp2 l, t;
+	fp2_init_none( &l );
+	fp2_init_none( &t );
+	mpz_set_ui( num->s0, 1 );
+	mpz_set_ui( num->s1, 0 );
+	mpz_set_ui( den->s0, 1 );
+	mpz_set_ui( den->s1, 0 );
+
+	for( int k = 0; k < M->len; k++ ) {
+		if( M->type[k] & MILLER_DBL ) {
+			fp2_sqr( num, num, p );
+			fp2_sqr( den, den, p );
+		}
+		fp2_sub( &l, &(Q->x), &(M->xT[k]), p );
+		if( !( M->type[k] & MILLER_VERTICAL ) ) {
+			fp2_mult( &l, &l, &(M->lambda[k]), p );
+			fp2_sub( &l, &(Q->y), &l, p );
+			fp2_sub( &l, &l, &(M->yT[k]), p );
+			fp2_sub( &t, &(Q->x), &(M->xN[k]), p );
+			fp2_mult( den, den, &t, p );
+		}
+		fp2_mult( num, num, &l, p );
+	}
+
+	fp2_clear( &l );
+	fp2_clear( &t );
+	return !fp2_is_zero( num, p ) && !fp2_is_zero( den, p );
+}
+
+static int miller_pair( fp2 *num, fp2 *den, miller_table *MR, miller_table *MS,
+	affine *R, affine *S, mpz_t n, mpz_t p ) {
+	/* Sets num/den as the unreduced pairing of order n of R and S, where 
+	MR is the table of R, and returns 1, or returns 0 if a point is on a
+	line. If MS is NULL, f_{n,R}( S ), for the reduced Tate pairing. 
+	Otherwise, with MS the table of S, the Weil pairing 
+	(-1)^n f_{n,R}( S )/f_{n,S}( R ). See pairings_reduce.
+	*/
+	int ok = miller_eval( num, den, MR, S, p );
+	if( ok && MS != NULL ) {
+		fp2 a, b;
+		fp2_init_none( &a );
+		fp2_init_none( &b );
+		ok = miller_eval( &a, &b, MS, R, p );
+		fp2_mult( num, num, &b, p );
+		fp2_mult( den, den, &a, p );
+		if( mpz_odd_p( n ) ) {
+			fp2_addinv( num, num, p );
+		}
+		fp2_clear( &a );
+		fp2_clear( &b );
+	}
+	return ok;
+}
+
+static void pairings_reduce( int count, fp2 res[count], fp2 num[count], fp2 den[count],
+	int weil, cyclo_exp *E, mpz_t p ) {
+	/* Sets res[i] as the pairing num[i]/den[i] given by miller_pair, with
+	a single inversion for the count pairings. For the Weil pairings, 
+	res[i] = num[i]/den[i]. For the Tate pairings, res[i] = f^( (p^2-1)/n ),
+	with f = num[i]/den[i] : f^(p-1) = conj( num ) den/( num conj( den ) ) 
+	has norm 1, and is raised to ( p+1 )/n with cyclo_pow, E holding its 
+	digits. res may be num.
+	*/
+	fp2 u[count], t;
+	fp2_init_none( &t );
+	for( int i = 0; i < count; i++ ) {
+		fp2_init_none( &(u[i]) );
+		if( weil ) {
+			fp2_set( &(u[i]), &(den[i]) );
+		}
+		else {
+			fp2_conj( &t, &(den[i]), p );
+			fp2_mult( &(u[i]), &(num[i]), &t, p );
+		}
+	}
+	fp2_batch_multinv( count, u, u, p );
+	for( int i = 0; i < count; i++ ) {
+		if( weil ) {
+			fp2_mult( &(res[i]), &(num[i]), &(u[i]), p );
+		}
+		else {
+			fp2_conj( &t, &(num[i]), p );
+			fp2_mult( &t, &t, &(den[i]), p );
+			fp2_mult( &t, &t, &(u[i]), p );
+			cyclo_pow( &(res[i]), &t, E, p );
+		}
+		fp2_clear( &(u[i]) );
+	}
+	fp2_clear( &t );
+}
+
+/* --------------------------------------------------------
+ 					DISCRETE LOGARITHMS
+----------------------------------------------------------*/
+
+#define DLOG_TRIES 1000 // elements tried to find a generator.
+
+struct dlog_table {
+	/* Tables of pk_compress for the points of order n = l^e, computed
+	once per parameters. The discrete logarithms are taken in base w,
+	a generator of the subgroup of order n of Fp2*, which does not
+	depend on the keys : inv[i*l + j] = w^( -j l^i ), for 0 <= i < e
+	and 0 <= j < l. E holds the digits of the exponent ( p+1 )/n of 
+	the reduced Tate pairings.
+	*/
+	int l;
+	int e;
+	fp2 *inv;
+	cyclo_exp E;
+};
+
+dlog_table *dlog_table_new( int l, int e, mpz_t p ) {
+	/* Returns the tables of pk_compress for the points of order l^e, or
+	NULL if no generator is found. w is the first z^( (p^2-1)/l^e ) of 
+	order l^e, for z = 1 + ki, k = 1, 2, ...
+	*/
+	mpz_t n, h;
+	mpz_inits( n, h, NULL );
+	mpz_ui_pow_ui( n, l, e );
+	mpz_add_ui( h, p, 1 );
+	if( e < 1 || !mpz_divisible_p( h, n ) ) {
+		mpz_clears( n, h, NULL );
+		return NULL;
+	}
+	mpz_divexact( h, h, n );
+
+	dlog_table *D = malloc( sizeof( dlog_table ) );
+	D->l = l;
+	D->e = e;
+	cyclo_exp_new( &(D->E), h );
+
+	fp2 w, t;
+	fp2_init_none( &w );
+	fp2_init_none( &t );
+	int found = 0;
+	for( int k = 1; k <= DLOG_TRIES && !found; k++ ) {
+		// w = z^(p-1) = conj( z )/z has norm 1, then w^( (p+1)/n ).
+		mpz_set_ui( t.s0, 1 );
+		mpz_set_ui( t.s1, k );
+		fp2_multinv( &w, &t, p );
+		fp2_conj( &t, &t, p );
+		fp2_mult( &w, &w, &t, p );
+		cyclo_pow( &w, &w, &(D->E), p );
+		// w has order n if w^( n/l ) != 1.
+		fp2_set( &t, &w );
+		for( int i = 0; i < e-1; i++ ) {
+			cyclo_pow_ui( &t, &t, l, p );
+		}
+		found = ( mpz_cmp_ui( t.s0, 1 ) != 0 || mpz_sgn( t.s1 ) != 0 );
+	}
+
+	D->inv = malloc( e*l*sizeof( fp2 ) );
+	fp2_conj( &t, &w, p ); // w^( -l^i ).
+	for( int i = 0; i < e; i++ ) {
+		for( int j = 0; j < l; j++ ) {
+			fp2 *c = &(D->inv[i*l + j]);
+			fp2_init_none( c );
+			if( j == 0 ) {
+				mpz_set_ui( c->s0, 1 );
+			}
+			else {
+				fp2_mult( c, &(D->inv[i*l + j-1]), &t, p );
+			}
+		}
+		cyclo_pow_ui( &t, &t, l, p );
+	}
+
+	fp2_clear( &w );
+	fp2_clear( &t );
+	mpz_clears( n, h, NULL );
+	if( !found ) {
+		dlog_table_free( D );
+		return NULL;
+	}
+	return D;
+}
+
+void dlog_table_free( dlog_table *D ) {
+	/* Frees a table given by dlog_table_new, or does nothing if D is NULL.
+	*/
+	if( D == NULL ) {
+		return;
+	}
+	for( int i = 0; i < D->e*D->l; i++ ) {
+		fp2_clear( &(D->inv[i]) );
+	}
+	free( D->inv );
+	cyclo_exp_clear( &(D->E) );
+	free( D );
+}
+
+static int dlog_rec( mpz_t x, fp2 *h, dlog_table *D, int k, mpz_t p ) {
+	/* Sets x < l^k such that h = w^( x l^(e-k) ), and returns 1, or
+	returns 0 if h is not in the subgroup of order l^k.
+	Pohlig-Hellman, splitting k in two halves, the powers of w being
+	read from D->inv : O( k log k ) operations.
+	*/
+	int l = D->l, off = D->e - k;
+	fp2 t;
+	fp2_init_none( &t );
+	if( k == 1 ) {
+		// h^-1 = w^( -x l^(e-1) ).
+		fp2_conj( &t, h, p );
+		int found = 0;
+		for( int j = 0; j < l && !found; j++ ) {
+			if( fp2_are_equal( &t, &(D->inv[off*l + j]) ) ) {
+				mpz_set_ui( x, j );
+				found = 1;
+			}
+		}
+		fp2_clear( &t );
+		return found;
+	}
+	int k1 = k/2, k2 = k - k1;
+	mpz_t x2, q;
+	mpz_inits( x2, q, NULL );
+
+	// h^(l^k2) = w^( x l^(e-k1) ) gives x1 = x mod l^k1.
+	fp2_set( &t, h );
+	for( int i = 0; i < k2; i++ ) {
+		cyclo_pow_ui( &t, &t, l, p );
+	}
+	int ok = dlog_rec( x, &t, D, k1, p );
+	// h w^( -x1 l^(e-k) ) = w^( x2 l^(e-k2) ), with x = x1 + l^k1 x2 : 
+	// the digit d of x1 at i gives the factor inv[( e-k+i )l + d].
+	if( ok ) {
+		fp2_set( &t, h );
+		mpz_set( q, x );
+		for( int i = 0; i < k1 && mpz_sgn( q ) > 0; i++ ) {
+			unsigned long d = mpz_fdiv_q_ui( q, q, l );
+			if( d ) {
+				fp2_mult( &t, &t, &(D->inv[( off+i )*l + d]), p );
+			}
+		}
+		ok = dlog_rec( x2, &t, D, k2, p );
+	}
+	if( ok ) {
+		mpz_ui_pow_ui( q, l, k1 );
+		mpz_addmul( x, q, x2 );
+	}
+
+	fp2_clear( &t );
+	mpz_clears( x2, q, NULL );
+	return ok;
+}
+
+static int dlog( mpz_t x, fp2 *h, dlog_table *D, mpz_t p ) {
+	/* Sets x < l^e such that h = w^x, and returns 1, or returns 0 if h
+	is not in the subgroup of order l^e.
+	*/
+	return dlog_rec( x, h, D, D->e, p );
+}
+
+/* --------------------------------------------------------
+ 					COMPRESSION
+----------------------------------------------------------*/
+
+void pkc_init_none( pk_compressed *CPK ) {
+	/* Initializes CPK with value 0 for every fields.
+	*/
+	fp2_init_none( &(CPK->A) );
+	mpz_inits( CPK->s[0], CPK->s[1], CPK->s[2], NULL );
+	CPK->normalized = 0;
+	CPK->root = 0;
+}
+
+void pkc_clear( pk_compressed *CPK ) {
+	/* Clears the fields of CPK.
+	*/
+	fp2_clear( &(CPK->A) );
+	mpz_clears( CPK->s[0], CPK->s[1], CPK->s[2], NULL );
+}
+
+static int beta_root( fp2 *beta, fp2 *A, int root, mpz_t p ) {
+	/* Sets beta as the root ( -A + (-1)^root sqrt( A^2 - 4 ) )/2 of
+	x^2 + Ax + 1, the abscissa of a two torsion point, and returns 1,
+	or returns 0 if A^2 - 4 is not a square.
+	*/
+	fp2 d, t;
+	fp2_init_none( &d );
+	fp2_init_none( &t );
+	fp2_mult( &t, A, A, p );
+	mpz_sub_ui( t.s0, t.s0, 4 );
+	mpz_mod( t.s0, t.s0, p );
+	int ok = fp2_sqrt( &d, &t, p );
+	if( root ) {
+		fp2_addinv( &d, &d, p );
+	}
+	fp2_sub( &d, &d, A, p );
+	// 1/2 = ( p+1 )/2.
+	mpz_t half;
+	mpz_init( half );
+	mpz_add_ui( half, p, 1 );
+	mpz_tdiv_q_2exp( half, half, 1 );
+	mpz_mul( beta->s0, d.s0, half );
+	mpz_mod( beta->s0, beta->s0, p );
+	mpz_mul( beta->s1, d.s1, half );
+	mpz_mod( beta->s1, beta->s1, p );
+	mpz_clear( half );
+	fp2_clear( &d );
+	fp2_clear( &t );
+	return ok;
+}
+
+static dlog_table *pk_dlog_table( int l, int e, parameters *param ) {
+	/* Returns the tables of the points of order l^e : the ones of
+	param for the sides A and B, a new one otherwise.
+	*/
+	if( l == param->pA && e == param->eA && param->dlogA != NULL ) {
+		return param->dlogA;
+	}
+	if( l == param->pB && e == param->eB && param->dlogB != NULL ) {
+		return param->dlogB;
+	}
+	return dlog_table_new( l, e, param->p );
+}
+
+int pk_compress( pk_compressed *CPK, pk *PK, int l, int e, parameters *param ) {
+	/* Sets CPK as the compression of PK, where the points of PK have
+	order l^e, and returns 1, or returns 0 if PK can't be compressed.
+
+	With ( R1, R2 ) the basis of the curve of PK, phi(P) = a0 R1 + b0 R2
+	and phi(Q) = a1 R1 + b1 R2. Since the pairing t is alternating,
+	t( R1, phi(P) ) = t( R1, R2 )^b0 and t( R2, phi(P) ) = t( R1, R2 )^-a0,
+	and the same for phi(Q). The scalars are divided by a0, or b0 if a0
+	is not invertible : phi(P) and phi(Q) are given up to a common
+	factor, which does not change the kernels of the key exchange.
+	The logarithms are taken in base w, the generator of the tables of
+	param ( see dlog_table_new ) : t( R1, R2 ) = w^c only multiplies the
+	four scalars by c, which the division cancels.
+	*/
+	int ok = 1;
+	mpz_t n, a[2], b[2], t;
+	mpz_inits( n, a[0], a[1], b[0], b[1], t, NULL );
+	mpz_ui_pow_ui( n, l, e );
+
+	if( PK->extended ) {
+		fp2_set( &(CPK->A), &(PK->A) );
+	}
+	else {
+		get_A( &(CPK->A), &(PK->x1), &(PK->x2), &(PK->x3), param->p );
+	}
+	fp2 *A = &(CPK->A);
+
+	affine R[2], phiP, phiQ;
+	affine_init( &(R[0]) );
+	affine_init( &(R[1]) );
+	affine_init( &phiP );
+	affine_init( &phiQ );
+	fp2 x;
+	fp2_init_none( &x );
+
+	// Points of PK, with y( phi(Q) ) such that x( phi(P)-phi(Q) ) = x3.
+	ok = affine_lift( &phiP, &(PK->x1), A, param->p )
+		&& affine_lift( &phiQ, &(PK->x2), A, param->p );
+	if( ok ) {
+		affine_diff_x( &x, &phiP, &phiQ, A, param->p );
+		if( !fp2_are_equal( &x, &(PK->x3) ) ) {
+			fp2_addinv( &(phiQ.y), &(phiQ.y), param->p );
+			affine_diff_x( &x, &phiP, &phiQ, A, param->p );
+			ok = fp2_are_equal( &x, &(PK->x3) );
+		}
+	}
+	ok = ok && torsion_basis( R, A, l, e, param->p );
+
+	dlog_table *D = pk_dlog_table( l, e, param );
+	ok = ok && D != NULL;
+
+	if( ok ) {
+		// The reduced Tate pairing is degenerate on E[l^e] if l divides 
+		// ( p+1 )/l^e, then the Weil pairing is used.
+		mpz_add_ui( t, param->p, 1 );
+		mpz_divexact( t, t, n );
+		int weil = mpz_divisible_ui_p( t, l );
+		affine *S[4] = { &(R[0]), &(R[1]), &phiP, &phiQ };
+		miller_table M[4];
+		miller_tables_new( weil ? 4 : 2, M, S, A, n, param->p );
+		// h = t( R1, phi(P) ), t( R2, phi(P) ), t( R1, phi(Q) ), t( R2, phi(Q) ).
+		fp2 h[4], d[4];
+		for( int i = 0; i < 4; i++ ) {
+			fp2_init_none( &(h[i]) );
+			fp2_init_none( &(d[i]) );
+		}
+		for( int i = 0; i < 4 && ok; i++ ) {
+			int r = i%2, s = 2 + i/2;
+			ok = miller_pair( &(h[i]), &(d[i]), &(M[r]), weil ? &(M[s]) : NULL, 
+				S[r], S[s], n, param->p );
+		}
+		if( ok ) {
+			pairings_reduce( 4, h, h, d, weil, &(D->E), param->p );
+			for( int i = 0; i < 2; i++ ) {
+				fp2_conj( &(h[2*i+1]), &(h[2*i+1]), param->p );
+				ok = ok && dlog( b[i], &(h[2*i]), D, param->p )
+					&& dlog( a[i], &(h[2*i+1]), D, param->p );
+			}
+		}
+		for( int i = 0; i < 4; i++ ) {
+			fp2_clear( &(h[i]) );
+			fp2_clear( &(d[i]) );
+		}
+		for( int i = 0; i < ( weil ? 4 : 2 ); i++ ) {
+			miller_table_clear( &(M[i]) );
+		}
+	}
+	if( D != param->dlogA && D != param->dlogB ) {
+		dlog_table_free( D );
+	}
+
+	if( ok ) {
+		CPK->normalized = mpz_divisible_ui_p( a[0], l );
+		ok = mpz_invert( t, CPK->normalized ? b[0] : a[0], n );
+		mpz_mul( CPK->s[0], CPK->normalized ? a[0] : b[0], t );
+		mpz_mul( CPK->s[1], a[1], t );
+		mpz_mul( CPK->s[2], b[1], t );
+		for( int i = 0; i < 3; i++ ) {
+			mpz_mod( CPK->s[i], CPK->s[i], n );
+		}
+	}
+
+	CPK->root = 0;
+	if( ok && param->pA != 2 ) {
+		ok = beta_root( &x, A, 0, param->p );
+		CPK->root = !fp2_are_equal( &x, &(PK->beta) );
+	}
+
+	affine_clear( &(R[0]) );
+	affine_clear( &(R[1]) );
+	affine_clear( &phiP );
+	affine_clear( &phiQ );
+	fp2_clear( &x );
+	mpz_clears( n, a[0], a[1], b[0], b[1], t, NULL );
+	return ok;
+}
+
+static int combination_x( fp2 *x, mpz_t c, mpz_t d, affine R[2], fp2 *xD,
+	int l, mpz_t n, curve *E, curve *F, mpz_t p ) {
+	/* Sets x as the abscissa of [c]R1 + [d]R2, of order n = l^e, where xD
+	is the abscissa of R1-R2, E is ( A : 1 ) and F is ( A+2 : 4 ) :
+	[c]( R1 + [d/c]R2 ) if c is invertible, [d]( R2 + [c/d]R1 ) otherwise.
+	Returns 1, or 0 if the point is not of order n.
+	*/
+	int swap = mpz_divisible_ui_p( c, l );
+	mpz_t u, m;
+	mpz_inits( u, m, NULL );
+	int ok = mpz_invert( u, swap ? d : c, n );
+	mpz_mul( m, u, swap ? c : d );
+	mpz_mod( m, m, n );
+
+	point S, T;
+	point_init_none( &S );
+	point_init_none( &T );
+	if( ok ) {
+		Ladder3pt( &S, m, &(R[swap].x), &(R[!swap].x), xD, E, p ); // R[swap] + [m]R[!swap].
+		Ladder( &T, &S, F, swap ? d : c, p );
+		ok = !fp2_is_zero( &(T.Z), p );
+		point_normalize_X( x, &T, p );
+	}
+
+	point_clear( &S );
+	point_clear( &T );
+	mpz_clears( u, m, NULL );
+	return ok;
+}
+
+int pk_decompress( pk *PK, pk_compressed *CPK, int l, int e, parameters *param ) {
+	/* Sets PK as the public key compressed in CPK, and returns 1, or
+	returns 0 if CPK is not a valid compressed key. PK is extended with
+	the coefficient A of its curve.
+	*/
+	mpz_t n, c[3], d[3];
+	mpz_inits( n, c[0], c[1], c[2], d[0], d[1], d[2], NULL );
+	mpz_ui_pow_ui( n, l, e );
+	fp2 *A = &(CPK->A);
+
+	affine R[2];
+	affine_init( &(R[0]) );
+	affine_init( &(R[1]) );
+	fp2 xD;
+	fp2_init_none( &xD );
+	curve E, F;
+	curve_init_none( &E );
+	curve_init_none( &F );
+	fp2_set( &(E.A), A );
+	mpz_set_ui( E.C.s0, 1 );
+	fp2_set( &(F.A), A );
+	mpz_add_ui( F.A.s0, F.A.s0, 2 );
+	mpz_set_ui( F.C.s0, 4 );
+
+	// phi(P), phi(Q) and phi(P)-phi(Q), as [c]R1 + [d]R2.
+	mpz_set_ui( CPK->normalized ? d[0] : c[0], 1 );
+	mpz_set( CPK->normalized ? c[0] : d[0], CPK->s[0] );
+	mpz_set( c[1], CPK->s[1] );
+	mpz_set( d[1], CPK->s[2] );
+	mpz_sub( c[2], c[0], c[1] );
+	mpz_mod( c[2], c[2], n );
+	mpz_sub( d[2], d[0], d[1] );
+	mpz_mod( d[2], d[2], n );
+
+	int ok = torsion_basis( R, A, l, e, param->p );
+	if( ok ) {
+		affine_diff_x( &xD, &(R[0]), &(R[1]), A, param->p );
+		fp2 *x[3] = { &(PK->x1), &(PK->x2), &(PK->x3) };
+		for( int i = 0; i < 3 && ok; i++ ) {
+			ok = combination_x( x[i], c[i], d[i], R, &xD, l, n, &E, &F, param->p );
+		}
+	}
+	if( ok && param->pA != 2 ) {
+		ok = beta_root( &(PK->beta), A, CPK->root, param->p );
+	}
+	fp2_set( &(PK->A), A );
+	PK->extended = 1;
+
+	affine_clear( &(R[0]) );
+	affine_clear( &(R[1]) );
+	fp2_clear( &xD );
+	curve_clear( &E );
+	curve_clear( &F );
+	mpz_clears( n, c[0], c[1], c[2], d[0], d[1], d[2], NULL );
+	return ok;
+}
+
+/* --------------------------------------------------------
+ 					ENCODING
+----------------------------------------------------------*/
+
+size_t pkc_bytes( int l, int e, parameters *param ) {
+	/* Returns the number of bytes of an encoded compressed key : A, the
+	three scalars mod l^e, and a byte for normalized and root.
+	*/
+	return 2*fp_bytes( param->p ) + 3*sk_bytes( l, e ) + 1;
+}
+
+void pkc_encode( unsigned char *out, pk_compressed *CPK, int l, int e, parameters *param ) {
+	/* Writes CPK on pkc_bytes( l, e, param ) bytes, little endian.
+	*/
+	size_t len = sk_bytes( l, e );
+	fp2_encode( out, &(CPK->A), param->p );
+	out += 2*fp_bytes( param->p );
+	for( int i = 0; i < 3; i++ ) {
+		fp_encode( out + i*len, CPK->s[i], len );
+	}
+	out[3*len] = CPK->normalized | ( CPK->root << 1 );
+}
+
+int pkc_decode( pk_compressed *CPK, const unsigned char *in, int l, int e, parameters *param ) {
+	/* Sets CPK from the pkc_bytes( l, e, param ) bytes of in, and returns
+	1 if A is reduced mod p and the scalars mod l^e, 0 otherwise.
+	*/
+	size_t len = sk_bytes( l, e );
+	int ok = fp2_decode( &(CPK->A), in, param->p );
+	in += 2*fp_bytes( param->p );
+	mpz_t n;
+	mpz_init( n );
+	mpz_ui_pow_ui( n, l, e );
+	for( int i = 0; i < 3; i++ ) {
+		fp_decode( CPK->s[i], in + i*len, len );
+		ok &= ( mpz_cmp( CPK->s[i], n ) < 0 );
+	}
+	CPK->normalized = in[3*len] & 1;
+	CPK->root = ( in[3*len] >> 1 ) & 1;
+	ok &= ( in[3*len] >> 2 ) == 0;
+	mpz_clear( n );
+	return ok;
+}
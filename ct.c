@@ -0,0 +1,289 @@
+/*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*
+*
+* Contains constant time Montgomery ladders, on fixed width
+* coordinates handled with the mpn_sec functions of gmp,
+* and branch-free conditional swaps.
+*
+*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include <gmp.h>
+#include "Header.h"
+
+/* --------------------------------------------------------
+                FIXED WIDTH ARITHMETIC PART
+----------------------------------------------------------*/
+
+/* An element of Fp is stored on n limbs, an element of Fp2 on 2n limbs
+( s0 then s1 ) and a point on 4n limbs ( X then Z ). Every value is
+reduced, and every operation runs the same instructions whatever the
+values.
+*/
+
+typedef struct ct_field {
+	mp_size_t n; // number of limbs of p.
+	mp_limb_t *p;
+	mp_limb_t *p2; // p^2, on 2n limbs.
+	mp_limb_t *t0; // 2n+1 limbs.
+	mp_limb_t *t1; // 2n+1 limbs.
+	mp_limb_t *t2; // 2n limbs.
+	mp_limb_t *u; // n limbs.
+	mp_limb_t *scratch;
+} ct_field;
+
+static void ct_field_init( ct_field *K, mpz_t p ) {
+	mp_size_t n = mpz_size( p );
+	K->n = n;
+
+	mp_size_t itch = mpn_sec_mul_itch( n, n );
+	mp_size_t itch2 = mpn_sec_div_r_itch( 2*n+1, n );
+	if( itch2 > itch ) {
+		itch = itch2;
+	}
+	K->p = calloc( 10*n + 2 + itch, sizeof( mp_limb_t ) );
+	K->p2 = K->p + n;
+	K->t0 = K->p2 + 2*n;
+	K->t1 = K->t0 + 2*n+1;
+	K->t2 = K->t1 + 2*n+1;
+	K->u = K->t2 + 2*n;
+	K->scratch = K->u + n;
+
+	mpn_copyi( K->p, mpz_limbs_read( p ), n );
+	mpn_sqr( K->p2, K->p, n );
+}
+
+static void ct_field_clear( ct_field *K ) {
+	free( K->p );
+}
+
+static void ct_load( ct_field *K, mp_limb_t *r, mpz_t a ) {
+	/* Sets the n limbs of r as a, with 0 <= a < p.
+	*/
+	mpn_zero( r, K->n );
+	mpn_copyi( r, mpz_limbs_read( a ), mpz_size( a ) );
+}
+
+static void ct_store( ct_field *K, mpz_t r, mp_limb_t *a ) {
+	/* Sets r as the n limbs of a.
+	*/
+	mpn_copyi( mpz_limbs_write( r, K->n ), a, K->n );
+	mpz_limbs_finish( r, K->n );
+}
+
+static void ct_add( ct_field *K, mp_limb_t *r, mp_limb_t *a, mp_limb_t *b ) {
+	/* Sets r as a+b mod p.
+	*/
+	mp_limb_t c = mpn_add_n( r, a, b, K->n );
+	mp_limb_t bw = mpn_sub_n( K->u, r, K->p, K->n );
+	mpn_cnd_swap( c | ( bw ^ 1 ), r, K->u, K->n );
+}
+
+static void ct_sub( ct_field *K, mp_limb_t *r, mp_limb_t *a, mp_limb_t *b ) {
+	/* Sets r as a-b mod p.
+	*/
+	mp_limb_t bw = mpn_sub_n( r, a, b, K->n );
+	mpn_cnd_add_n( bw, r, r, K->p, K->n );
+}
+
+static void ct_fp2_add( ct_field *K, mp_limb_t *r, mp_limb_t *a, mp_limb_t *b ) {
+	ct_add( K, r, a, b );
+	ct_add( K, r + K->n, a + K->n, b + K->n );
+}
+
+static void ct_fp2_sub( ct_field *K, mp_limb_t *r, mp_limb_t *a, mp_limb_t *b ) {
+	ct_sub( K, r, a, b );
+	ct_sub( K, r + K->n, a + K->n, b + K->n );
+}
+
+static void ct_fp2_mult( ct_field *K, mp_limb_t *r, mp_limb_t *a, mp_limb_t *b ) {
+	/* Sets r as a*b, with two reductions :
+	s0 = a0*b0 + ( p^2 - a1*b1 ) and s1 = a0*b1 + a1*b0, both < 2p^2.
+	r can be a or b.
+	*/
+	mp_size_t n = K->n;
+	mp_limb_t *a0 = a, *a1 = a + n, *b0 = b, *b1 = b + n;
+
+	mpn_sec_mul( K->t0, a0, n, b1, n, K->scratch );
+	mpn_sec_mul( K->t2, a1, n, b0, n, K->scratch );
+	K->t0[2*n] = mpn_add_n( K->t0, K->t0, K->t2, 2*n );
+
+	mpn_sec_mul( K->t1, a0, n, b0, n, K->scratch );
+	mpn_sec_mul( K->t2, a1, n, b1, n, K->scratch );
+	mpn_sub_n( K->t2, K->p2, K->t2, 2*n );
+	K->t1[2*n] = mpn_add_n( K->t1, K->t1, K->t2, 2*n );
+
+	mpn_sec_div_r( K->t0, 2*n+1, K->p, n, K->scratch );
+	mpn_sec_div_r( K->t1, 2*n+1, K->p, n, K->scratch );
+	mpn_copyi( r, K->t1, n );
+	mpn_copyi( r + n, K->t0, n );
+}
+
+static void ct_xDBLADD( ct_field *K, mp_limb_t *P, mp_limb_t *Q, mp_limb_t *D,
+	mp_limb_t *A, mp_limb_t *C, mp_limb_t *t ) {
+	/* Sets P as P+P and Q as P+Q, where D = Q-P, on the curve
+	( A+2C : 4C ) = ( A : C ). t holds 5 temporary elements of Fp2.
+	*/
+	mp_size_t m = 2*K->n;
+	mp_limb_t *PX = P, *PZ = P + m, *QX = Q, *QZ = Q + m, *DX = D, *DZ = D + m;
+	mp_limb_t *t0 = t, *t1 = t + m, *t2 = t + 2*m, *t3 = t + 3*m, *t4 = t + 4*m;
+
+	ct_fp2_add( K, t0, PX, PZ );
+	ct_fp2_sub( K, t1, PX, PZ );
+	ct_fp2_sub( K, t2, QX, QZ );
+	ct_fp2_add( K, t3, QX, QZ );
+	ct_fp2_mult( K, t2, t0, t2 );
+	ct_fp2_mult( K, t3, t1, t3 );
+
+	ct_fp2_add( K, t4, t2, t3 );
+	ct_fp2_mult( K, t4, t4, t4 );
+	ct_fp2_mult( K, QX, t4, DZ );
+	ct_fp2_sub( K, t4, t2, t3 );
+	ct_fp2_mult( K, t4, t4, t4 );
+	ct_fp2_mult( K, QZ, t4, DX );
+
+	ct_fp2_mult( K, t0, t0, t0 );
+	ct_fp2_mult( K, t1, t1, t1 );
+	ct_fp2_mult( K, t4, C, t1 );
+	ct_fp2_mult( K, PX, t4, t0 );
+	ct_fp2_sub( K, t0, t0, t1 );
+	ct_fp2_mult( K, t1, A, t0 );
+	ct_fp2_add( K, t4, t4, t1 );
+	ct_fp2_mult( K, PZ, t4, t0 );
+}
+
+/* --------------------------------------------------------
+                	LADDERS PART
+----------------------------------------------------------*/
+
+typedef struct ct_ladder {
+	/* Everything a ladder needs, on a single allocation.
+	*/
+	ct_field K;
+	mp_limb_t *limbs;
+	mp_limb_t *R0, *R1, *R2; // three points.
+	mp_limb_t *A, *C; // the curve.
+	mp_limb_t *t; // five elements of Fp2.
+	mp_limb_t *k; // the scalar.
+} ct_ladder;
+
+static void ct_ladder_init( ct_ladder *L, curve *F, mpz_t m, int bits, mpz_t p ) {
+	ct_field_init( &(L->K), p );
+	mp_size_t n = L->K.n;
+	mp_size_t kn = ( bits + GMP_NUMB_BITS - 1 ) / GMP_NUMB_BITS;
+	L->limbs = calloc( 26*n + kn + 1, sizeof( mp_limb_t ) );
+	L->R0 = L->limbs;
+	L->R1 = L->R0 + 4*n;
+	L->R2 = L->R1 + 4*n;
+	L->A = L->R2 + 4*n;
+	L->C = L->A + 2*n;
+	L->t = L->C + 2*n;
+	L->k = L->t + 10*n;
+
+	ct_load( &(L->K), L->A, F->A.s0 );
+	ct_load( &(L->K), L->A + n, F->A.s1 );
+	ct_load( &(L->K), L->C, F->C.s0 );
+	ct_load( &(L->K), L->C + n, F->C.s1 );
+
+	// The scalar is read on kn limbs whatever its size, without branch :
+	// the limbs above the size of m are masked to 0 ( limb 0 is read in 
+	// their place, always allocated ), and the ones above 2^bits ignored.
+	const mp_limb_t *d = mpz_limbs_read( m );
+	mp_limb_t mn = mpz_size( m );
+	for( mp_size_t i = 0; i < kn; i++ ) {
+		mp_limb_t mask = -( ( (mp_limb_t) i - mn ) >> ( GMP_LIMB_BITS - 1 ) );
+		L->k[i] = d[i & mask] & mask;
+	}
+}
+
+static void ct_ladder_clear( ct_ladder *L ) {
+	free( L->limbs );
+	ct_field_clear( &(L->K) );
+}
+
+static void ct_load_point( ct_ladder *L, mp_limb_t *R, fp2 *X, fp2 *Z ) {
+	/* Sets R as ( X : Z ), or ( X : 1 ) if Z is NULL.
+	*/
+	mp_size_t n = L->K.n;
+	ct_load( &(L->K), R, X->s0 );
+	ct_load( &(L->K), R + n, X->s1 );
+	if( Z == NULL ) {
+		mpn_zero( R + 2*n, 2*n );
+		R[2*n] = 1;
+	}
+	else {
+		ct_load( &(L->K), R + 2*n, Z->s0 );
+		ct_load( &(L->K), R + 3*n, Z->s1 );
+	}
+}
+
+static void ct_store_point( ct_ladder *L, point *R, mp_limb_t *P ) {
+	mp_size_t n = L->K.n;
+	ct_store( &(L->K), R->X.s0, P );
+	ct_store( &(L->K), R->X.s1, P + n );
+	ct_store( &(L->K), R->Z.s0, P + 2*n );
+	ct_store( &(L->K), R->Z.s1, P + 3*n );
+}
+
+static mp_limb_t ct_bit( ct_ladder *L, int i ) {
+	return ( L->k[i / GMP_NUMB_BITS] >> ( i % GMP_NUMB_BITS ) ) & 1;
+}
+
+void Ladder_ct( point *R, point *P, curve *F, mpz_t m, int bits, mpz_t p ) {
+	/* Sets R as [m]P, with addition on curve F, in constant time : the
+	ladder always runs on bits bits, starting from the point at infinity.
+	*/
+	ct_ladder L;
+	ct_ladder_init( &L, F, m, bits, p );
+	mp_size_t n = L.K.n;
+
+	mpn_zero( L.R0, 4*n );
+	L.R0[0] = 1; // R0 = ( 1 : 0 ).
+	ct_load_point( &L, L.R1, &(P->X), &(P->Z) );
+	ct_load_point( &L, L.R2, &(P->X), &(P->Z) );
+
+	mp_limb_t prev = 0;
+	for( int i = bits-1; i >= 0; i-- ) {
+		// Invariant : R1 - R0 = P.
+		mp_limb_t b = ct_bit( &L, i );
+		mpn_cnd_swap( b ^ prev, L.R0, L.R1, 4*n );
+		prev = b;
+		ct_xDBLADD( &(L.K), L.R0, L.R1, L.R2, L.A, L.C, L.t );
+	}
+	mpn_cnd_swap( prev, L.R0, L.R1, 4*n );
+	ct_store_point( &L, R, L.R0 );
+
+	ct_ladder_clear( &L );
+}
+
+void Ladder3pt_ct( point *QplusmP, mpz_t m, int bits,
+	fp2 *xP, fp2 *xQ, fp2 *xQminusP, curve *F, mpz_t p ) {
+	/* Same as Ladder3pt_without_conversion in constant time : the ladder
+	always runs on bits bits, and each step is the same xDBLADD between
+	conditional swaps.
+	*/
+	ct_ladder L;
+	ct_ladder_init( &L, F, m, bits, p );
+	mp_size_t n = L.K.n;
+
+	ct_load_point( &L, L.R0, xQ, NULL );
+	ct_load_point( &L, L.R1, xP, NULL );
+	ct_load_point( &L, L.R2, xQminusP, NULL );
+
+	mp_limb_t prev = 0;
+	for( int i = 0; i < bits; i++ ) {
+		// A bit 1 updates R1 with difference R2, a bit 0 updates R2 with
+		// difference R1, ie R1 after a swap.
+		mp_limb_t s = ct_bit( &L, i ) ^ 1;
+		mpn_cnd_swap( s ^ prev, L.R1, L.R2, 4*n );
+		prev = s;
+		ct_xDBLADD( &(L.K), L.R0, L.R1, L.R2, L.A, L.C, L.t );
+	}
+	mpn_cnd_swap( prev, L.R1, L.R2, 4*n );
+	ct_store_point( &L, QplusmP, L.R1 );
+
+	ct_ladder_clear( &L );
+}
@@ -0,0 +1,158 @@
+/*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*
+*
+* Contains the contexts of the library : the state a thread
+* needs to run key generations, exchanges and the KEM on a
+* set of parameters shared with other threads, without any
+* lock. See the CONTEXT PART of Header.h for the contract.
+*
+*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <gmp.h>
+#include "Header.h"
+
+/* --------------------------------------------------------
+ 					CONTEXT
+----------------------------------------------------------*/
+
+void ctx_init( ctx *C, parameters *param ) {
+	/* Initializes C on the parameters param, without pool and with the
+	public key options of param, and seeds its generator.
+	The copy shares the prime, the points, the strategies and the tables
+	of param, which are only read : param has to outlive C, and must not
+	be set again while C is used.
+	*/
+	C->param = *param;
+	drbg_init( &(C->D) );
+	C->param.W = NULL;
+}
+
+void ctx_clear( ctx *C ) {
+	/* Erases the generator of C. The shared fields of the parameters are
+	left to clear_parameters.
+	*/
+	drbg_clear( &(C->D) );
+	memset( &(C->param), 0, sizeof( parameters ) );
+}
+
+void ctx_set_pool( ctx *C, pool *W ) {
+	/* The images of the points will be computed on the threads of W
+	(NULL for none), for the calls on C only.
+	*/
+	C->param.W = W;
+}
+
+void ctx_set_extended_pk( ctx *C, int extended, int validate ) {
+	/* Same as set_extended_pk, for the calls on C only. The other party
+	does not need the same options, see kem.c.
+	*/
+	C->param.extended_pk = extended;
+	C->param.validate_pk = validate;
+}
+
+void ctx_set_constant_time( ctx *C, int ct ) {
+	/* Same as set_constant_time, for the calls on C only.
+	*/
+	C->param.constant_time = ct;
+}
+
+/* --------------------------------------------------------
+ 					KEYS AND EXCHANGE
+----------------------------------------------------------*/
+
+void ctx_isogen( ctx *C, pk *PK, sk *SK, int side ) {
+	/* Key generation of the side A if side is 0, B otherwise, with the
+	2/3 or the generalized functions depending on the parameters.
+	*/
+	parameters *param = &(C->param);
+	if( param->pA == 2 ) {
+		if( side == 0 ) {
+			isogen_two( PK, SK, param );
+		}
+		else {
+			isogen_three( PK, SK, param );
+		}
+	}
+	else {
+		if( side == 0 ) {
+			isogen_Alice( PK, SK, param );
+		}
+		else {
+			isogen_Bob( PK, SK, param );
+		}
+	}
+}
+
+void ctx_keygen( ctx *C, pk *PK, sk *SK, int side ) {
+	/* Initializes SK with a uniform secret from the generator of C, and
+	sets PK as its public key, on the side A if side is 0, B otherwise.
+	*/
+	parameters *param = &(C->param);
+	if( side == 0 ) {
+		sk_generate( SK, param->pA, param->eA, &(C->D) );
+	}
+	else {
+		sk_generate( SK, param->pB, param->eB, &(C->D) );
+	}
+	ctx_isogen( C, PK, SK, side );
+}
+
+void ctx_keygen_batch( ctx *C, int n, pk PK[n], sk SK[n], int side ) {
+	/* Same as ctx_keygen for n keys, with isogen_batch : the keys are
+	spread on the pool of C.
+	*/
+	parameters *param = &(C->param);
+	int l = ( side == 0 ) ? param->pA : param->pB;
+	int e = ( side == 0 ) ? param->eA : param->eB;
+	for( int i = 0; i < n; i++ ) {
+		sk_generate( &(SK[i]), l, e, &(C->D) );
+	}
+	isogen_batch( n, PK, SK, side, param, param->W );
+}
+
+void ctx_isoex( ctx *C, fp2 *j, sk *SK, pk *PK, int side ) {
+	/* Key exchange of the side A if side is 0, B otherwise : sets j as
+	the shared secret of SK and the public key PK of the other side.
+	*/
+	parameters *param = &(C->param);
+	if( param->pA == 2 ) {
+		if( side == 0 ) {
+			isoex_two( j, SK, PK, param );
+		}
+		else {
+			isoex_three( j, SK, PK, param );
+		}
+	}
+	else {
+		if( side == 0 ) {
+			isoex_Alice( j, PK, SK, param );
+		}
+		else {
+			isoex_Bob( j, PK, SK, param );
+		}
+	}
+}
+
+/* --------------------------------------------------------
+ 					KEM
+----------------------------------------------------------*/
+
+void ctx_kem_keygen( ctx *C, pk *PK, kem_sk *SK ) {
+	/* Same as kem_keygen, with the options of C.
+	*/
+	kem_keygen( PK, SK, &(C->param) );
+}
+
+void ctx_kem_encaps( ctx *C, unsigned char K[KEM_BYTES], kem_ct *CT, pk *PK ) {
+	/* Same as kem_encaps, with the options of C.
+	*/
+	kem_encaps( K, CT, PK, &(C->param) );
+}
+
+void ctx_kem_decaps( ctx *C, unsigned char K[KEM_BYTES], kem_ct *CT, kem_sk *SK ) {
+	/* Same as kem_decaps, with the options of C.
+	*/
+	kem_decaps( K, CT, SK, &(C->param) );
+}
@@ -0,0 +1,197 @@
+/*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*
+*
+* Timing leakage test of the ladders, in the spirit of dudect
+* (Reparaz, Balasch, Verbauwhede) : the running times for a
+* fixed secret and for random secrets are compared with a
+* Welch t-test. Build with "make dudect", run "./Dudect [n]".
+*
+*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include <gmp.h>
+#include "Header.h"
+
+#define T_THRESHOLD 4.5 // above, the two classes have different timings.
+#define WARMUP 20
+
+typedef struct welch {
+	/* Online mean and variance of the two classes.
+	*/
+	double n[2];
+	double mean[2];
+	double m2[2];
+} welch;
+
+static void welch_push( welch *W, int c, double x ) {
+	W->n[c]++;
+	double delta = x - W->mean[c];
+	W->mean[c] += delta / W->n[c];
+	W->m2[c] += delta * ( x - W->mean[c] );
+}
+
+static double welch_t( welch *W ) {
+	double v0 = W->m2[0] / ( W->n[0] - 1 );
+	double v1 = W->m2[1] / ( W->n[1] - 1 );
+	return ( W->mean[0] - W->mean[1] ) / sqrt( v0/W->n[0] + v1/W->n[1] );
+}
+
+static double now( void ) {
+	struct timespec t;
+	clock_gettime( CLOCK_MONOTONIC, &t );
+	return t.tv_sec*1e9 + t.tv_nsec;
+}
+
+typedef struct inputs {
+	mpz_t p;
+	int bits;
+	fp2 xP, xQ, xR;
+	curve F; // ( a24 : 1 ).
+	point P;
+} inputs;
+
+static void random_fp2( fp2 *a, gmp_randstate_t state, mpz_t p ) {
+	mpz_urandomm( a->s0, state, p );
+	mpz_urandomm( a->s1, state, p );
+}
+
+static void ladder3pt_ct( point *R, mpz_t m, inputs *I ) {
+	Ladder3pt_ct( R, m, I->bits, &(I->xP), &(I->xQ), &(I->xR), &(I->F), I->p );
+}
+
+static void ladder3pt( point *R, mpz_t m, inputs *I ) {
+	Ladder3pt_without_conversion( R, m, &(I->xP), &(I->xQ), &(I->xR), &(I->F), I->p );
+}
+
+static void ladder_ct( point *R, mpz_t m, inputs *I ) {
+	Ladder_ct( R, &(I->P), &(I->F), m, I->bits, I->p );
+}
+
+static void ladder( point *R, mpz_t m, inputs *I ) {
+	Ladder( R, &(I->P), &(I->F), m, I->p );
+}
+
+static double leakage( void (*f)( point *R, mpz_t m, inputs *I ),
+	inputs *I, int measures, gmp_randstate_t state ) {
+	/* Runs f measures times, on the fixed secret 1 (class 0) or on a
+	random secret of I->bits bits (class 1), and returns the t value.
+	*/
+	welch W;
+	memset( &W, 0, sizeof( welch ) );
+	point R;
+	point_init_none( &R );
+	mpz_t m;
+	mpz_init( m );
+
+	for( int i = 0; i < WARMUP + measures; i++ ) {
+		int c = gmp_urandomb_ui( state, 1 );
+		if( c == 0 ) {
+			mpz_set_ui( m, 1 );
+		}
+		else {
+			mpz_urandomb( m, state, I->bits );
+		}
+		double t0 = now();
+		f( &R, m, I );
+		double t1 = now();
+		if( i >= WARMUP ) {
+			welch_push( &W, c, t1-t0 );
+		}
+	}
+
+	point_clear( &R );
+	mpz_clear( m );
+	return welch_t( &W );
+}
+
+static int same_x( point *R, point *S, mpz_t p ) {
+	fp2 x, y;
+	fp2_init_none( &x );
+	fp2_init_none( &y );
+	point_normalize_X( &x, R, p );
+	point_normalize_X( &y, S, p );
+	int same = fp2_are_equal( &x, &y );
+	fp2_clear( &x );
+	fp2_clear( &y );
+	return same;
+}
+
+int main( int argc, char *argv[] ) {
+	int measures = ( argc > 1 ) ? atoi( argv[1] ) : 2000;
+
+	// p = 2^250*3^159 - 1, and random inputs : the formulas do not
+	// depend on the points being on the curve.
+	inputs I;
+	mpz_inits( I.p, NULL );
+	mpz_t t;
+	mpz_init( t );
+	mpz_ui_pow_ui( I.p, 2, 250 );
+	mpz_ui_pow_ui( t, 3, 159 );
+	mpz_mul( I.p, I.p, t );
+	mpz_sub_ui( I.p, I.p, 1 );
+	I.bits = 250;
+
+	gmp_randstate_t state;
+	gmp_randinit_default( state );
+	gmp_randseed_ui( state, time( NULL ) );
+
+	fp2_init_none( &(I.xP) );
+	fp2_init_none( &(I.xQ) );
+	fp2_init_none( &(I.xR) );
+	curve_init_ui( &(I.F), 0, 0, 1, 0, I.p );
+	point_init_ui( &(I.P), 0, 0, 1, 0, I.p );
+	random_fp2( &(I.xP), state, I.p );
+	random_fp2( &(I.xQ), state, I.p );
+	random_fp2( &(I.xR), state, I.p );
+	random_fp2( &(I.F.A), state, I.p );
+	random_fp2( &(I.P.X), state, I.p );
+
+	// Both versions have to agree.
+	point R, S;
+	point_init_none( &R );
+	point_init_none( &S );
+	mpz_urandomb( t, state, I.bits );
+	ladder3pt( &R, t, &I );
+	ladder3pt_ct( &S, t, &I );
+	int ok = same_x( &R, &S, I.p );
+	ladder( &R, t, &I );
+	ladder_ct( &S, t, &I );
+	ok = ok && same_x( &R, &S, I.p );
+	printf("Constant time ladders agree with the ladders : %d\n", ok );
+
+	struct {
+		const char *name;
+		void (*f)( point *R, mpz_t m, inputs *I );
+		int ct;
+	} tests[4] = {
+		{ "Ladder3pt_ct", ladder3pt_ct, 1 },
+		{ "Ladder_ct", ladder_ct, 1 },
+		{ "Ladder3pt", ladder3pt, 0 },
+		{ "Ladder", ladder, 0 },
+	};
+
+	printf("%d measures per ladder, fixed secret against random secrets :\n", measures );
+	for( int i = 0; i < 4; i++ ) {
+		double tv = leakage( tests[i].f, &I, measures, state );
+		int leak = fabs( tv ) > T_THRESHOLD;
+		printf("  %-13s t = %8.2f  %s\n", tests[i].name, tv,
+			leak ? "timing leakage" : "no leakage detected" );
+		if( tests[i].ct && leak ) {
+			ok = 0;
+		}
+	}
+
+	point_clear( &R );
+	point_clear( &S );
+	point_clear( &(I.P) );
+	curve_clear( &(I.F) );
+	fp2_clear( &(I.xP) );
+	fp2_clear( &(I.xQ) );
+	fp2_clear( &(I.xR) );
+	gmp_randclear( state );
+	mpz_clears( I.p, t, NULL );
+	return ok ? 0 : 1;
+}
@@ -211,6 +211,208 @@ void fp2_set( fp2 *res, fp2 *a ) {
 	mpz_set( res->s1, a->s1 );
 }
 
+void fp2_batch_multinv( int n, fp2 res[n], fp2 a[n], mpz_t p ) {
+	/* Fills res[i] with the multiplicative inverse of a[i], for 0 <= i < n,
+	using Montgomery's trick : one single fp2_multinv and 3(n-1) multiplications.
+	res and a may be the same array.
+
+	WATCH OUT ! None of the a[i] can be zero.
+	*/
+	if( n <= 0 ) {
+		return;
+	}
+	fp2 acc[n], inv, tmp;
+	for( int i = 0; i < n; i++ ) {
+		fp2_init_none( &(acc[i]) );
+	}
+	fp2_init_none( &inv );
+	fp2_init_none( &tmp );
+
+	// acc[i] = a[0] * ... * a[i].
+	fp2_set( &(acc[0]), &(a[0]) );
+	for( int i = 1; i < n; i++ ) {
+		fp2_mult( &(acc[i]), &(acc[i-1]), &(a[i]), p );
+	}
+
+	fp2_multinv( &inv, &(acc[n-1]), p );
+	// Now inv = ( a[0] * ... * a[i] )^(-1), with i going down.
+	for( int i = n-1; i > 0; i-- ) {
+		fp2_mult( &tmp, &inv, &(acc[i-1]), p );
+		fp2_mult( &inv, &inv, &(a[i]), p );
+		fp2_set( &(res[i]), &tmp );
+	}
+	fp2_set( &(res[0]), &inv );
+
+	for( int i = 0; i < n; i++ ) {
+		fp2_clear( &(acc[i]) );
+	}
+	fp2_clear( &inv );
+	fp2_clear( &tmp );
+}
+
+void fp2_pow_ui( fp2 *res, fp2 *a, unsigned long e, mpz_t p ) {
+	/* Sets res as a^e, using square and multiply.
+	*/
+	fp2 base, acc;
+	fp2_init_none( &base );
+	fp2_init_none( &acc );
+	fp2_set( &base, a );
+	mpz_set_ui( acc.s0, 1 );
+
+	while( e > 0 ) {
+		if( e & 1 ) {
+			fp2_mult( &acc, &acc, &base, p );
+		}
+		e >>= 1;
+		if( e > 0 ) {
+			fp2_mult( &base, &base, &base, p );
+		}
+	}
+	fp2_set( res, &acc );
+
+	fp2_clear( &base );
+	fp2_clear( &acc );
+}
+
+void fp2_pow( fp2 *res, fp2 *a, mpz_t e, mpz_t p ) {
+	/* Sets res as a^e, with e >= 0, using square and multiply.
+	*/
+	fp2 acc;
+	fp2_init_none( &acc );
+	mpz_set_ui( acc.s0, 1 );
+
+	for( long i = (long) mpz_sizeinbase( e, 2 ) - 1; i >= 0; i-- ) {
+		fp2_mult( &acc, &acc, &acc, p );
+		if( mpz_tstbit( e, i ) ) {
+			fp2_mult( &acc, &acc, a, p );
+		}
+	}
+	fp2_set( res, &acc );
+
+	fp2_clear( &acc );
+}
+
+int fp2_sqrt( fp2 *res, fp2 *a, mpz_t p ) {
+	/* Sets res as a square root of a, and returns 1 if a is a square.
+	Otherwise returns 0, and res is meaningless.
+	Uses the algorithm from Adj and Rodriguez-Henriquez for p = 3 mod 4 :
+	a1 = a^((p-3)/4), alpha = a1² a, x0 = a1 a, then
+	res = i x0 if alpha = -1, and res = (1+alpha)^((p-1)/2) x0 otherwise.
+	*/
+	mpz_t e;
+	mpz_init( e );
+	fp2 a1, alpha, x0, check;
+	fp2_init_none( &a1 );
+	fp2_init_none( &alpha );
+	fp2_init_none( &x0 );
+	fp2_init_none( &check );
+
+	mpz_sub_ui( e, p, 3 );
+	mpz_fdiv_q_2exp( e, e, 2 );
+	fp2_pow( &a1, a, e, p );
+	fp2_mult( &x0, &a1, a, p );
+	fp2_mult( &alpha, &a1, &x0, p );
+
+	mpz_add_ui( alpha.s0, alpha.s0, 1 );
+	mpz_mod( alpha.s0, alpha.s0, p );
+	if( fp2_is_zero( &alpha, p ) ) {
+		// alpha = -1, res = i*x0.
+		fp2_addinv( &check, &x0, p );
+		mpz_set( res->s0, check.s1 );
+		mpz_set( res->s1, x0.s0 );
+	}
+	else {
+		// Now alpha is 1 + alpha.
+		mpz_sub_ui( e, p, 1 );
+		mpz_fdiv_q_2exp( e, e, 1 );
+		fp2_pow( &alpha, &alpha, e, p );
+		fp2_mult( res, &alpha, &x0, p );
+	}
+
+	fp2_mult( &check, res, res, p );
+	int is_square = fp2_are_equal( &check, a );
+
+	fp2_clear( &a1 );
+	fp2_clear( &alpha );
+	fp2_clear( &x0 );
+	fp2_clear( &check );
+	mpz_clear( e );
+	return is_square;
+}
+
+/* --------------------------------------------------------
+                    ENCODING
+----------------------------------------------------------*/
+
+size_t fp_bytes( mpz_t p ) {
+	/* Returns the number of bytes of an encoded element of Fp.
+	*/
+	return ( mpz_sizeinbase( p, 2 ) + 7 )/8;
+}
+
+void fp_encode( unsigned char *out, mpz_t a, size_t len ) {
+	/* Writes a on len bytes, little endian. 
+	*/
+	size_t n = mpz_size( a );
+	const mp_limb_t *l = mpz_limbs_read( a );
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+	size_t m = n*sizeof( mp_limb_t );
+	if( m > len ) {
+		m = len; // only zero bytes are dropped, since a < 2^(8len).
+	}
+	memcpy( out, l, m );
+	memset( out + m, 0, len - m );
+#else
+	for( size_t i = 0; i < len; i++ ) {
+		size_t k = i/sizeof( mp_limb_t );
+		out[i] = ( k < n ) ? l[k] >> ( 8*( i%sizeof( mp_limb_t ) ) ) : 0;
+	}
+#endif
+}
+
+void fp_decode( mpz_t a, const unsigned char *in, size_t len ) {
+	/* Sets a from the len bytes of in, little endian, written 
+	directly in the limbs of a.
+	*/
+	if( len == 0 ) {
+		mpz_set_ui( a, 0 );
+		return;
+	}
+	size_t n = ( len + sizeof( mp_limb_t ) - 1 )/sizeof( mp_limb_t );
+	mp_limb_t *l = mpz_limbs_write( a, n );
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+	l[n-1] = 0;
+	memcpy( l, in, len );
+#else
+	for( size_t k = 0; k < n; k++ ) {
+		l[k] = 0;
+	}
+	for( size_t i = 0; i < len; i++ ) {
+		l[i/sizeof( mp_limb_t )] |= 
+			(mp_limb_t) in[i] << ( 8*( i%sizeof( mp_limb_t ) ) );
+	}
+#endif
+	mpz_limbs_finish( a, n );
+}
+
+void fp2_encode( unsigned char *out, fp2 *a, mpz_t p ) {
+	/* Writes s0 then s1, on fp_bytes( p ) bytes each.
+	*/
+	size_t len = fp_bytes( p );
+	fp_encode( out, a->s0, len );
+	fp_encode( out + len, a->s1, len );
+}
+
+int fp2_decode( fp2 *a, const unsigned char *in, mpz_t p ) {
+	/* Sets a from the 2*fp_bytes( p ) bytes of in, and returns 1 if
+	both coordinates are reduced mod p, 0 otherwise.
+	*/
+	size_t len = fp_bytes( p );
+	fp_decode( a->s0, in, len );
+	fp_decode( a->s1, in + len, len );
+	return mpz_cmp( a->s0, p ) < 0 && mpz_cmp( a->s1, p ) < 0;
+}
+
 /* 
 HEY ! LISTEN : the prime p has to be 3 mod 4, to avoid
 having -1 in Fp. Think about it while testing...
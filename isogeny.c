@@ -20,6 +20,61 @@
                      REGULAR PART
 -----------------------------------------------------------*/
 
+void two_iso_curve( curve *F, point *P2, mpz_t p ) {
+	/* Sets F as the two-isogenous curve, ie F = E/<P2>,
+	where P2 has order 2 and is not (0 : 1).
+
+	WATCH OUT : F will be in the form AplusC = (A+2C : 4C)
+	*/
+	fp2 t;
+	fp2_init_none(&t);
+
+	fp2_mult( &t, &(P2->X), &(P2->X), p );
+	fp2_mult( &(F->C), &(P2->Z), &(P2->Z), p );
+	fp2_sub( &(F->A), &(F->C), &t, p );
+
+	fp2_clear(&t);
+}
+
+void two_iso_eval_batch( int n, point *Q[n], point *P2, point *P[n], mpz_t p ) {
+	/* Sets Q[i] as phi(P[i]) for the n points, where phi is the 
+	two-isogeny of kernel <P2>. Q[i] can be the same as P[i].
+	*/
+	fp2 K1, K2, t0, t1, t2;
+	fp2_init_none(&K1);
+	fp2_init_none(&K2);
+	fp2_init_none(&t0);
+	fp2_init_none(&t1);
+	fp2_init_none(&t2);
+
+	fp2_add( &K1, &(P2->X), &(P2->Z), p );
+	fp2_sub( &K2, &(P2->X), &(P2->Z), p );
+
+	for( int i = 0; i < n; i++ ) {
+		fp2_add( &t2, &(P[i]->X), &(P[i]->Z), p );
+		fp2_sub( &t1, &(P[i]->X), &(P[i]->Z), p );
+		fp2_mult( &t0, &K1, &t1, p );
+		fp2_mult( &t1, &K2, &t2, p );
+		fp2_add( &t2, &t0, &t1, p );
+		fp2_sub( &t0, &t0, &t1, p );
+
+		fp2_mult( &(Q[i]->X), &(P[i]->X), &t2, p );
+		fp2_mult( &(Q[i]->Z), &(P[i]->Z), &t0, p );
+	}
+
+	fp2_clear(&K1);
+	fp2_clear(&K2);
+	fp2_clear(&t0);
+	fp2_clear(&t1);
+	fp2_clear(&t2);
+}
+
+void two_iso_eval( point *Q, point *P2, point *P, mpz_t p ) {
+	/* Sets Q as phi(P), where phi is the two-isogeny of kernel <P2>.
+	*/
+	two_iso_eval_batch( 1, &Q, P2, &P, p );
+}
+
 void four_iso_curve( curve *F, fp2 *K1, fp2 *K2, fp2 *K3, 
 	point *P4, mpz_t p ) {
 	/* Sets F as the four-isogenous curve, ie F = E/<P4>,
@@ -82,6 +137,51 @@ void four_iso_eval( point* Q,
 	fp2_clear(&t1);
 }
 
+void four_iso_eval_batch( int n, point *Q[n], 
+	fp2 *K1, fp2 *K2, fp2 *K3, point *P[n], mpz_t p ) {
+	/* Sets Q[i] as phi(P[i]) for the n points, where phi is a 
+	four-isogeny described by K1, K2 and K3. Same as four_iso_eval,
+	but the temporaries are shared by all the points.
+	Q[i] can be the same as P[i].
+	*/
+	fp2 t0, t1, X, Z;
+	fp2_init_none(&t0);
+	fp2_init_none(&t1);
+	fp2_init_none(&X);
+	fp2_init_none(&Z);
+
+	for( int i = 0; i < n; i++ ) {
+		fp2_add( &t0, &(P[i]->X), &(P[i]->Z), p );
+		fp2_sub( &t1, &(P[i]->X), &(P[i]->Z), p );
+		fp2_mult( &X, &t0, K2, p );
+		fp2_mult( &Z, &t1, K3, p );
+
+		fp2_mult( &t0, &t0, &t1, p );
+		fp2_mult( &t0, &t0, K1, p );
+		fp2_add( &t1, &X, &Z, p );
+		fp2_sub( &Z, &X, &Z, p );
+
+		fp2_mult( &t1, &t1, &t1, p );
+		fp2_mult( &Z, &Z, &Z, p );
+		fp2_add( &X, &t0, &t1, p );
+		fp2_sub( &t0, &Z, &t0, p );
+
+		fp2_mult( &X, &X, &t1, p );
+		fp2_mult( &Z, &Z, &t0, p );
+
+		// The old coordinates of Q[i] go to X and Z, overwritten next time.
+		mpz_swap( Q[i]->X.s0, X.s0 );
+		mpz_swap( Q[i]->X.s1, X.s1 );
+		mpz_swap( Q[i]->Z.s0, Z.s0 );
+		mpz_swap( Q[i]->Z.s1, Z.s1 );
+	}
+
+	fp2_clear(&t0);
+	fp2_clear(&t1);
+	fp2_clear(&X);
+	fp2_clear(&Z);
+}
+
 void three_iso_curve( curve *F, fp2 *K1, fp2 *K2, 
 	point* P, mpz_t p ) {
 	/* Sets F as the three-isogenous curve, ie F = E/<P>,
@@ -166,6 +266,38 @@ void three_iso_eval( point *phiP,
 	fp2_clear(&t2);
 }
 
+void three_iso_eval_batch( int n, point *Q[n], 
+	fp2 *K1, fp2 *K2, point *P[n], mpz_t p ) {
+	/* Sets Q[i] as phi(P[i]) for the n points, where phi is a 
+	three-isogeny described by K1 and K2. Same as three_iso_eval,
+	but the temporaries are shared by all the points.
+	Q[i] can be the same as P[i].
+	*/
+	fp2 t0, t1, t2;
+	fp2_init_none(&t0);
+	fp2_init_none(&t1);
+	fp2_init_none(&t2);
+
+	for( int i = 0; i < n; i++ ) {
+		fp2_add( &t0, &(P[i]->X), &(P[i]->Z), p );
+		fp2_sub( &t1, &(P[i]->X), &(P[i]->Z), p );
+		fp2_mult( &t0, K1, &t0, p );
+
+		fp2_mult( &t1, K2, &t1, p );
+		fp2_add( &t2, &t0, &t1, p );
+		fp2_sub( &t0, &t1, &t0, p );
+
+		fp2_mult( &t2, &t2, &t2, p );
+		fp2_mult( &t0, &t0, &t0, p );
+		fp2_mult( &(Q[i]->X), &(P[i]->X), &t2, p );
+		fp2_mult( &(Q[i]->Z), &(P[i]->Z), &t0, p );
+	}
+
+	fp2_clear(&t0);
+	fp2_clear(&t1);
+	fp2_clear(&t2);
+}
+
 void two_e_iso( curve *F, point *phiP1, point *phiP2, point *phiP3,
 	curve *E, point *S, point *P1, point *P2, point *P3, 
 	int e2, mpz_t p ) {
@@ -189,15 +321,19 @@ void two_e_iso( curve *F, point *phiP1, point *phiP2, point *phiP3,
 	fp2_init_none(&K1);
 	fp2_init_none(&K2);
 	fp2_init_none(&K3);
+	point *Q[4] = { S, phiP1, phiP2, phiP3 };
 
 	for( int e = e2-2; e >=0; e = e - 2 ) {
 		xDBLe( &T, S, &G, p, e );
 		four_iso_curve( &G, &K1, &K2, &K3, &T, p );
-		four_iso_eval( S, &K1, &K2, &K3, S, p );
-		// optional :
-		four_iso_eval( phiP1, &K1, &K2, &K3, phiP1, p );
-		four_iso_eval( phiP2, &K1, &K2, &K3, phiP2, p );
-		four_iso_eval( phiP3, &K1, &K2, &K3, phiP3, p );
+		// phiP1, phiP2, phiP3 are optional.
+		four_iso_eval_batch( 4, Q, &K1, &K2, &K3, Q, p );
+	}
+	if( e2 % 2 == 1 ) {
+		// Now S has order 2.
+		point_set( &T, S );
+		two_iso_curve( &G, &T, p );
+		two_iso_eval_batch( 4, Q, &T, Q, p );
 	}
 
 	curve_set( F, &G );
@@ -231,15 +367,13 @@ void three_e_iso( curve *F, point *phiP1, point *phiP2, point *phiP3,
 	fp2 K1, K2;
 	fp2_init_none(&K1);
 	fp2_init_none(&K2);
+	point *Q[4] = { S, phiP1, phiP2, phiP3 };
 
 	for( int e = e3-1; e >=0; e-- ) {
 		xTPLe( &T, S, &G, p, e );
 		three_iso_curve( &G, &K1, &K2, &T, p );
-		three_iso_eval( S, &K1, &K2, S, p );
-		// optional :
-		three_iso_eval( phiP1, &K1, &K2, phiP1, p );
-		three_iso_eval( phiP2, &K1, &K2, phiP2, p );
-		three_iso_eval( phiP3, &K1, &K2, phiP3, p );
+		// phiP1, phiP2, phiP3 are optional.
+		three_iso_eval_batch( 4, Q, &K1, &K2, Q, p );
 	}
 
 	curve_set( F, &G );
@@ -341,6 +475,924 @@ void odd_isogeny( point *S, int d, point ker[d], point *P, mpz_t p ) {
 }
 
 
+void odd_iso_curve( curve *E, int d, point ker[d], curve *F, mpz_t p ) {
+	/* Sets E as the codomain of the odd isogeny of degree l = 2d+1 and
+	kernel ker, with F its domain, without evaluating any two torsion point.
+	Uses the twisted Edwards coefficients a = A+2C and d = A-2C, following
+	Moody and Shumow : a' = a^l (prod Xi)^8 and d' = d^l (prod Zi)^8.
+
+	WATCH OUT ! The kernel points have to be in reshaped form (X+Z, X-Z),
+	and F (input) and E (output) are in the form ( A+2C : 4C ) !
+	*/
+	fp2 a, e, pX, pZ;
+	fp2_init_none( &a );
+	fp2_init_none( &e );
+	fp2_init_none( &pX );
+	fp2_init_none( &pZ );
+
+	fp2_set( &pX, &(ker[0].X) );
+	fp2_set( &pZ, &(ker[0].Z) );
+	for( int i=1; i<d; i++ ) {
+		fp2_mult( &pX, &pX, &(ker[i].X), p );
+		fp2_mult( &pZ, &pZ, &(ker[i].Z), p );
+	}
+	for( int i=0; i<3; i++ ) {
+		fp2_mult( &pX, &pX, &pX, p );
+		fp2_mult( &pZ, &pZ, &pZ, p );
+	}
+
+	fp2_set( &a, &(F->A) );
+	fp2_sub( &e, &(F->A), &(F->C), p );
+	// Now (a : e) = (A+2C : A-2C).
+	fp2_pow_ui( &a, &a, 2*d+1, p );
+	fp2_pow_ui( &e, &e, 2*d+1, p );
+	fp2_mult( &a, &a, &pX, p );
+	fp2_mult( &e, &e, &pZ, p );
+
+	fp2_set( &(E->A), &a );
+	fp2_sub( &(E->C), &a, &e, p );
+
+	fp2_clear( &a );
+	fp2_clear( &e );
+	fp2_clear( &pX );
+	fp2_clear( &pZ );
+}
+
+/* ---------------------------------------------------------
+                    SQRT VELU PART
+-----------------------------------------------------------*/
+
+/* The kernel <G> of order l is split with S = { 1, 3, ..., l-2 }
+as S = ( I + J ) U ( I - J ) U K, where
+I = { 2b(2i+1), 0 <= i < b' }, J = { 2j+1, 0 <= j < b }, and
+K = { 4bb'+1, ..., l-2 }, with b = floor( sqrt(l-1)/2 ).
+Then h_S(X) = prod( X - x([s]G) ) is recovered as a resultant
+between h_I and a product over J, following Bernstein, De Feo,
+Leroux and Smith.
+*/
+
+/* Costs measured with bench_sqrt_velu on primes of 503 bits : an
+fp2_multinv takes about 10 fp2_mult, and a multiplication counted by
+sqrt_velu_cost takes 1.4 (five points) to 1.7 (one point) times as long
+as one counted by velu_cost, since the additions and the allocations of
+the trees are not counted. Then the crossover is around l = 400.
+*/
+#define INV_COST 10
+#define SQRT_VELU_WEIGHT 140 // in percents of a multiplication of velu_cost
+
+static void sqrt_velu_sizes( int l, int *b, int *bp, int *nk ) {
+	/* Sets b = #J, bp = #I and nk = #K for an l-isogeny.
+	*/
+	*b = (int) floor( sqrt( (double)( l-1 ) ) / 2 );
+	if( *b <= 0 ) {
+		*bp = 0;
+		*nk = ( l-1 )/2;
+		return;
+	}
+	*bp = ( l-1 )/( 4*(*b) );
+	*nk = ( l-1 )/2 - 2*(*b)*(*bp);
+}
+
+static void sqrt_velu_EJ( fp2 *E, sqrt_velu *V, fp2 *X, fp2 *Z, mpz_t p ) {
+	/* Sets E (2b+1 coefficients) as the product over j in J of
+	X²F0(W, xj) + XZ F1(W, xj) + Z²F2(W, xj), where 
+	F0(W, xj) = (W - xj)², F1(W, xj) = -2( (W xj + 1)(W + xj) + 2A W xj )
+	and F2(W, xj) = (W xj - 1)².
+	*/
+	int b = V->b;
+	fp2 XX, ZZ, XZ, t;
+	fp2_init_none( &XX );
+	fp2_init_none( &ZZ );
+	fp2_init_none( &XZ );
+	fp2_init_none( &t );
+	fp2 *fac = poly_new( 3*b );
+
+	fp2_mult( &XX, X, X, p );
+	fp2_mult( &ZZ, Z, Z, p );
+	fp2_mult( &XZ, X, Z, p );
+	fp2_add( &XX, &XX, &ZZ, p );
+	// Now XX = X² + Z².
+
+	for( int j = 0; j < b; j++ ) {
+		// W^0 : ( xj X - Z )².
+		fp2_mult( &t, &(V->xJ[j]), X, p );
+		fp2_sub( &t, &t, Z, p );
+		fp2_mult( &(fac[3*j]), &t, &t, p );
+
+		// W^1 : -2( xj (X² + Z²) + XZ ( xj² + 1 + 2A xj ) ).
+		fp2_mult( &t, &(V->xJ[j]), &XX, p );
+		fp2_mult( &(fac[3*j+1]), &XZ, &(V->tJ[j]), p );
+		fp2_add( &(fac[3*j+1]), &(fac[3*j+1]), &t, p );
+		fp2_add( &(fac[3*j+1]), &(fac[3*j+1]), &(fac[3*j+1]), p );
+		fp2_addinv( &(fac[3*j+1]), &(fac[3*j+1]), p );
+
+		// W^2 : ( X - xj Z )².
+		fp2_mult( &t, &(V->xJ[j]), Z, p );
+		fp2_sub( &t, X, &t, p );
+		fp2_mult( &(fac[3*j+2]), &t, &t, p );
+	}
+
+	poly_product( E, b, 2, fac, p );
+
+	poly_free( 3*b, fac );
+	fp2_clear( &XX );
+	fp2_clear( &ZZ );
+	fp2_clear( &XZ );
+	fp2_clear( &t );
+}
+
+static void sqrt_velu_hK( fp2 *h0, fp2 *h1, sqrt_velu *V, fp2 *X, fp2 *Z, mpz_t p ) {
+	/* Sets h0 as prod( X - xk Z ) and h1 as prod( Z - xk X ), for k in K.
+	*/
+	fp2 t;
+	fp2_init_none( &t );
+	mpz_set_ui( h0->s0, 1 );
+	mpz_set_ui( h0->s1, 0 );
+	mpz_set_ui( h1->s0, 1 );
+	mpz_set_ui( h1->s1, 0 );
+
+	for( int k = 0; k < V->nk; k++ ) {
+		fp2_mult( &t, &(V->xK[k]), Z, p );
+		fp2_sub( &t, X, &t, p );
+		fp2_mult( h0, h0, &t, p );
+		fp2_mult( &t, &(V->xK[k]), X, p );
+		fp2_sub( &t, Z, &t, p );
+		fp2_mult( h1, h1, &t, p );
+	}
+	fp2_clear( &t );
+}
+
+void sqrt_velu_init( sqrt_velu *V, int l, point *G, curve *F, mpz_t p ) {
+	/* Precomputes what is needed to evaluate the l-isogeny of kernel <G>
+	with the square-root Velu formulas : x([s]G) for s in I, J and K,
+	normalized with a single inversion, and the product tree of h_I.
+
+	WATCH OUT ! F has to be in the form (A+2C : 4C), and l >= 5.
+	*/
+	int b, bp, nk;
+	sqrt_velu_sizes( l, &b, &bp, &nk );
+	V->l = l;
+	V->b = b;
+	V->bp = bp;
+	V->nk = nk;
+	V->xJ = poly_new( b );
+	V->tJ = poly_new( b );
+	V->xK = poly_new( nk > 0 ? nk : 1 );
+	fp2 *xI = poly_new( bp );
+	fp2_init_none( &(V->A) );
+
+	int n = b + bp + nk;
+	point pts[n], P2, D;
+	for( int i = 0; i < n; i++ ) {
+		point_init_none( &(pts[i]) );
+	}
+	point_init_none( &P2 );
+	point_init_none( &D );
+	point *ptJ = pts, *ptI = pts + b, *ptK = pts + b + bp;
+	mpz_t m;
+	mpz_init( m );
+
+	xDBL( &P2, G, F, p );
+
+	// J : [1]G, [3]G, ..., [2b-1]G, adding 2G each time.
+	point_set( &(ptJ[0]), G );
+	if( b >= 2 ) {
+		xADD( &(ptJ[1]), G, &P2, G, p );
+	}
+	for( int j = 2; j < b; j++ ) {
+		xADD( &(ptJ[j]), &(ptJ[j-1]), &P2, &(ptJ[j-2]), p );
+	}
+
+	// I : [2b]G, [6b]G, ..., adding 4bG each time.
+	mpz_set_ui( m, 2*b );
+	Ladder( &(ptI[0]), G, F, m, p );
+	xDBL( &D, &(ptI[0]), F, p );
+	if( bp >= 2 ) {
+		xADD( &(ptI[1]), &(ptI[0]), &D, &(ptI[0]), p );
+	}
+	for( int i = 2; i < bp; i++ ) {
+		xADD( &(ptI[i]), &(ptI[i-1]), &D, &(ptI[i-2]), p );
+	}
+
+	// K : [4bb'+1]G, ..., [l-2]G, adding 2G each time.
+	if( nk > 0 ) {
+		mpz_set_ui( m, 4*b*bp + 1 );
+		Ladder( &(ptK[0]), G, F, m, p );
+		mpz_set_ui( m, 4*b*bp - 1 );
+		Ladder( &D, G, F, m, p );
+	}
+	if( nk >= 2 ) {
+		xADD( &(ptK[1]), &(ptK[0]), &P2, &D, p );
+	}
+	for( int k = 2; k < nk; k++ ) {
+		xADD( &(ptK[k]), &(ptK[k-1]), &P2, &(ptK[k-2]), p );
+	}
+
+	// Normalization of all the points, and of A, with one inversion.
+	fp2 Z[n+1];
+	for( int i = 0; i < n; i++ ) {
+		fp2_init_none( &(Z[i]) );
+		fp2_set( &(Z[i]), &(pts[i].Z) );
+	}
+	fp2_init_none( &(Z[n]) );
+	fp2_set( &(Z[n]), &(F->C) );
+	fp2_batch_multinv( n+1, Z, Z, p );
+
+	for( int j = 0; j < b; j++ ) {
+		fp2_mult( &(V->xJ[j]), &(ptJ[j].X), &(Z[j]), p );
+	}
+	for( int i = 0; i < bp; i++ ) {
+		fp2_mult( &(xI[i]), &(ptI[i].X), &(Z[b+i]), p );
+	}
+	for( int k = 0; k < nk; k++ ) {
+		fp2_mult( &(V->xK[k]), &(ptK[k].X), &(Z[b+bp+k]), p );
+	}
+
+	// A = 4 (A+2C)/4C - 2.
+	fp2 two;
+	fp2_init_none( &two );
+	mpz_set_ui( two.s0, 2 );
+	fp2_mult( &(V->A), &(F->A), &(Z[n]), p );
+	fp2_add( &(V->A), &(V->A), &(V->A), p );
+	fp2_add( &(V->A), &(V->A), &(V->A), p );
+	fp2_sub( &(V->A), &(V->A), &two, p );
+
+	// tJ = xj² + 1 + 2A xj.
+	fp2 t;
+	fp2_init_none( &t );
+	for( int j = 0; j < b; j++ ) {
+		fp2_mult( &t, &(V->A), &(V->xJ[j]), p );
+		fp2_add( &t, &t, &t, p );
+		fp2_mult( &(V->tJ[j]), &(V->xJ[j]), &(V->xJ[j]), p );
+		fp2_add( &(V->tJ[j]), &(V->tJ[j]), &t, p );
+		mpz_add_ui( V->tJ[j].s0, V->tJ[j].s0, 1 );
+		mpz_mod( V->tJ[j].s0, V->tJ[j].s0, p );
+	}
+
+	poly_tree_build( &(V->hI), bp, xI, p );
+
+	fp2_clear( &t );
+	fp2_clear( &two );
+	for( int i = 0; i <= n; i++ ) {
+		fp2_clear( &(Z[i]) );
+	}
+	for( int i = 0; i < n; i++ ) {
+		point_clear( &(pts[i]) );
+	}
+	point_clear( &P2 );
+	point_clear( &D );
+	poly_free( bp, xI );
+	mpz_clear( m );
+}
+
+void sqrt_velu_clear( sqrt_velu *V ) {
+	/* Clears the fields of V.
+	*/
+	poly_free( V->b, V->xJ );
+	poly_free( V->b, V->tJ );
+	poly_free( V->nk > 0 ? V->nk : 1, V->xK );
+	poly_tree_clear( &(V->hI) );
+	fp2_clear( &(V->A) );
+}
+
+void sqrt_velu_eval( point *S, sqrt_velu *V, point *P, mpz_t p ) {
+	/* Sets S as phi(P), where phi is the isogeny described by V.
+	Gives the same point as odd_isogeny, up to the projective factor.
+	*/
+	int b = V->b;
+	fp2 *E0 = poly_new( 2*b+1 );
+	fp2 *E1 = poly_new( 2*b+1 );
+	fp2 R0, R1, h0, h1;
+	fp2_init_none( &R0 );
+	fp2_init_none( &R1 );
+	fp2_init_none( &h0 );
+	fp2_init_none( &h1 );
+
+	sqrt_velu_EJ( E0, V, &(P->X), &(P->Z), p );
+	// E1 is E0 with X and Z swapped, ie its reciprocal polynomial.
+	for( int i = 0; i <= 2*b; i++ ) {
+		fp2_set( &(E1[i]), &(E0[2*b-i]) );
+	}
+	poly_tree_eval_prod( &R0, &(V->hI), E0, 2*b+1, p );
+	poly_tree_eval_prod( &R1, &(V->hI), E1, 2*b+1, p );
+	sqrt_velu_hK( &h0, &h1, V, &(P->X), &(P->Z), p );
+
+	// Now R0*h0 = c * prod( X - xs Z ) and R1*h1 = c * prod( Z - xs X ).
+	fp2_mult( &R0, &R0, &h0, p );
+	fp2_mult( &R1, &R1, &h1, p );
+	fp2_mult( &R0, &R0, &R0, p );
+	fp2_mult( &R1, &R1, &R1, p );
+	fp2_mult( &(S->X), &(P->X), &R1, p );
+	fp2_mult( &(S->Z), &(P->Z), &R0, p );
+
+	poly_free( 2*b+1, E0 );
+	poly_free( 2*b+1, E1 );
+	fp2_clear( &R0 );
+	fp2_clear( &R1 );
+	fp2_clear( &h0 );
+	fp2_clear( &h1 );
+}
+
+void sqrt_velu_curve( curve *F, sqrt_velu *V, mpz_t p ) {
+	/* Sets F as the codomain of the isogeny described by V, using the
+	twisted Edwards coefficients a = A+2 and d = A-2 :
+	a' = a^l h_S(-1)^8 and d' = d^l h_S(1)^8.
+
+	WATCH OUT ! F will be in the form (A+2C : 4C) = (a' : a'-d').
+	*/
+	int b = V->b;
+	fp2 *E = poly_new( 2*b+1 );
+	fp2 one, minus_one, hp, hm, h1, a, d;
+	fp2_init_none( &one );
+	fp2_init_none( &minus_one );
+	fp2_init_none( &hp );
+	fp2_init_none( &hm );
+	fp2_init_none( &h1 );
+	fp2_init_none( &a );
+	fp2_init_none( &d );
+	mpz_set_ui( one.s0, 1 );
+	fp2_addinv( &minus_one, &one, p );
+
+	// hp = c * h_S(1), and hm = c * h_S(-1).
+	sqrt_velu_EJ( E, V, &one, &one, p );
+	poly_tree_eval_prod( &hp, &(V->hI), E, 2*b+1, p );
+	sqrt_velu_hK( &h1, &a, V, &one, &one, p );
+	fp2_mult( &hp, &hp, &h1, p );
+
+	sqrt_velu_EJ( E, V, &minus_one, &one, p );
+	poly_tree_eval_prod( &hm, &(V->hI), E, 2*b+1, p );
+	sqrt_velu_hK( &h1, &a, V, &minus_one, &one, p );
+	fp2_mult( &hm, &hm, &h1, p );
+
+	for( int i = 0; i < 3; i++ ) {
+		fp2_mult( &hp, &hp, &hp, p );
+		fp2_mult( &hm, &hm, &hm, p );
+	}
+
+	fp2_add( &a, &(V->A), &one, p );
+	fp2_add( &a, &a, &one, p );
+	fp2_sub( &d, &(V->A), &one, p );
+	fp2_sub( &d, &d, &one, p );
+	fp2_pow_ui( &a, &a, V->l, p );
+	fp2_pow_ui( &d, &d, V->l, p );
+	fp2_mult( &a, &a, &hm, p );
+	fp2_mult( &d, &d, &hp, p );
+
+	fp2_set( &(F->A), &a );
+	fp2_sub( &(F->C), &a, &d, p );
+
+	poly_free( 2*b+1, E );
+	fp2_clear( &one );
+	fp2_clear( &minus_one );
+	fp2_clear( &hp );
+	fp2_clear( &hm );
+	fp2_clear( &h1 );
+	fp2_clear( &a );
+	fp2_clear( &d );
+}
+
+long ladder_cost( int m ) {
+	/* Returns the number of fp2 multiplications done by Ladder on [m].
+	*/
+	int bits = 0;
+	while( ( m >> bits ) > 0 ) {
+		bits++;
+	}
+	return 6 + 12*( bits-1 );
+}
+
+long velu_cost( int l, int npoints ) {
+	/* Returns the number of fp2 multiplications needed to compute
+	the kernel of an l-isogeny, and to evaluate npoints points
+	with odd_isogeny.
+	*/
+	int d = ( l-1 )/2;
+	return 6*( d-1 ) + (long)npoints*( 4*d + 2 );
+}
+
+long sqrt_velu_cost( int l, int npoints ) {
+	/* Returns the number of fp2 multiplications needed by sqrt_velu_init
+	for an l-isogeny, and by sqrt_velu_eval on npoints points.
+	*/
+	int b, bp, nk;
+	sqrt_velu_sizes( l, &b, &bp, &nk );
+	int n = b + bp + nk;
+
+	long init = 6 + ladder_cost( 2*b ) + 6 + 6*( b-1 ) + 6*( bp-1 );
+	if( nk > 0 ) {
+		init += ladder_cost( 4*b*bp + 1 ) + ladder_cost( 4*b*bp - 1 ) + 6*( nk-1 );
+	}
+	init += 3*n + INV_COST + n + 1 + 2*b + poly_tree_build_cost( bp );
+
+	long eval = 3 + 6*b + poly_product_cost( b, 2 ) 
+		+ 2*poly_tree_eval_prod_cost( bp, 2*b+1 ) + 4*nk + 6;
+
+	return init + (long)npoints*eval;
+}
+
+int sqrt_velu_is_faster( int l, int npoints ) {
+	/* Returns 1 if the square-root Velu formulas are cheaper than
+	the linear ones, for an l-isogeny evaluated on npoints points.
+	The crossover is thus chosen for each l, from the operation counts
+	weighted with the measured SQRT_VELU_WEIGHT.
+	*/
+	if( l < 5 ) {
+		return 0;
+	}
+	return SQRT_VELU_WEIGHT*sqrt_velu_cost( l, npoints ) < 100*velu_cost( l, npoints );
+}
+
+
+/* ---------------------------------------------------------
+                    STRATEGY PART
+-----------------------------------------------------------*/
+
+/* An isogeny of degree l^e is a chain of n steps. Instead of computing
+each step kernel from the kernel generator, which costs O(n^2) 
+multiplications by l, the optimal strategies from De Feo, Jao and Plut
+keep a stack of intermediate points, pushed through each isogeny.
+A strategy is stored as the list of the n-1 numbers of multiplications
+by l, in the order they are done.
+The points pushed through each isogeny are independent, so they can be
+computed on the threads of a pool.
+*/
+
+// Costs of the steps, counted in fp2 multiplications.
+#define DBL_COST 6 // xDBL.
+#define TWO_CURVE_COST 2 // two_iso_curve.
+#define TWO_EVAL_COST 4 // two_iso_eval.
+#define FOUR_CURVE_COST 4 // four_iso_curve.
+#define FOUR_EVAL_COST 9 // four_iso_eval.
+#define THREE_MUL_COST 12 // xTPL.
+#define THREE_EVAL_COST 6 // three_iso_eval.
+
+static void strategy_fill( int n, int strategy[], int split[], int *pos ) {
+	/* Writes the strategy for n steps from the optimal splits, 
+	in the order of the traversal : the root, the left part then the
+	right part.
+	*/
+	if( n <= 1 ) {
+		return;
+	}
+	int m = split[n];
+	strategy[(*pos)++] = m;
+	strategy_fill( n-m, strategy, split, pos );
+	strategy_fill( m, strategy, split, pos );
+}
+
+static long strategy_split( int n, long mul_cost, long eval_cost, int split[] ) {
+	/* Returns the cost of the optimal strategy for a chain of n steps, 
+	and sets split[i] (if not NULL) as the number of multiplications
+	at the root of the optimal strategy for i steps, for i <= n.
+	*/
+	if( n <= 1 ) {
+		return 0;
+	}
+	long *cost = malloc( ( n+1 )*sizeof( long ) );
+	int *own = NULL;
+	if( split == NULL ) {
+		own = malloc( ( n+1 )*sizeof( int ) );
+		split = own;
+	}
+	cost[1] = 0;
+	split[1] = 0;
+
+	for( int i = 2; i <= n; i++ ) {
+		cost[i] = -1;
+		for( int m = 1; m < i; m++ ) {
+			// m multiplications by l, then the left part of i-m steps, 
+			// while the stacked point is pushed through i-m isogenies. 
+			long c = cost[i-m] + cost[m] + m*mul_cost + ( i-m )*eval_cost;
+			if( cost[i] < 0 || c < cost[i] ) {
+				cost[i] = c;
+				split[i] = m;
+			}
+		}
+	}
+
+	long total = cost[n];
+	free( cost );
+	free( own );
+	return total;
+}
+
+void optimal_strategy( int n, int strategy[], long mul_cost, long eval_cost ) {
+	/* Sets strategy (n-1 values) as the optimal strategy for a chain of
+	n steps, with mul_cost for a multiplication by l and eval_cost for 
+	the image of a point.
+	*/
+	if( n <= 1 ) {
+		return;
+	}
+	int *split = malloc( ( n+1 )*sizeof( int ) );
+	strategy_split( n, mul_cost, eval_cost, split );
+
+	int pos = 0;
+	strategy_fill( n, strategy, split, &pos );
+
+	free( split );
+}
+
+static long two_step_eval_cost( int b ) {
+	/* Returns the cost of the image of a point by a step of 2^b.
+	*/
+	return ( b == 2 ) ? FOUR_EVAL_COST : FOUR_EVAL_COST + TWO_EVAL_COST;
+}
+
+int two_chain_step( int e2 ) {
+	/* Returns the number b of doublings per step in the chain of a 2^e2
+	isogeny : 2 for 4-isogenies, 3 for 8-isogenies (a 4-isogeny followed
+	by a 2-isogeny). The e2 mod b last doublings are done by a final 2- or
+	4-isogeny. b is chosen from the operation counts of a key generation,
+	with the strategy, the kernels and the 3 public points.
+	*/
+	long best = -1;
+	int best_b = 2;
+
+	for( int b = 2; b <= 3; b++ ) {
+		int n = e2/b;
+		int r = e2 % b;
+		long eval = two_step_eval_cost( b );
+		long kernel = ( b == 2 ) ? FOUR_CURVE_COST : 
+			DBL_COST + FOUR_CURVE_COST + FOUR_EVAL_COST + TWO_CURVE_COST;
+
+		long cost = strategy_split( n, b*DBL_COST, eval, NULL ) + n*( kernel + 3*eval );
+		if( r == 1 ) {
+			// The kernel point is pushed through the chain, for the last step.
+			cost += n*eval + TWO_CURVE_COST + 3*TWO_EVAL_COST;
+		}
+		else if( r == 2 ) {
+			cost += n*eval + FOUR_CURVE_COST + 3*FOUR_EVAL_COST;
+		}
+
+		if( best < 0 || cost < best ) {
+			best = cost;
+			best_b = b;
+		}
+	}
+	return best_b;
+}
+
+int strategy_steps( int l, int e ) {
+	/* Returns the number of steps in the chain of an l^e isogeny,
+	made of 4- or 8-isogenies if l = 2 (see two_chain_step), 
+	of l-isogenies otherwise.
+	*/
+	return ( l == 2 ) ? e/two_chain_step( e ) : e;
+}
+
+int *strategy_new( int l, int e, int regular ) {
+	/* Returns a strategy for an l^e isogeny, to be freed with free.
+	The costs are the ones of two_e_iso_strategy and three_e_iso_strategy
+	if regular is set to 1, and of odd_e_iso_strategy otherwise.
+	*/
+	int n = strategy_steps( l, e );
+	int *strategy = malloc( ( n > 1 ? n-1 : 1 )*sizeof( int ) );
+
+	if( l == 2 ) {
+		int b = two_chain_step( e );
+		optimal_strategy( n, strategy, b*DBL_COST, two_step_eval_cost( b ) );
+	}
+	else if( l == 3 && regular ) {
+		optimal_strategy( n, strategy, THREE_MUL_COST, THREE_EVAL_COST );
+	}
+	else {
+		long eval = sqrt_velu_is_faster( l, 1 ) ? 
+			SQRT_VELU_WEIGHT*( sqrt_velu_cost( l, 1 ) - sqrt_velu_cost( l, 0 ) )/100 
+			: 4*( ( l-1 )/2 ) + 2;
+		optimal_strategy( n, strategy, ladder_cost( l ), eval );
+	}
+	return strategy;
+}
+
+static int chunk_size( int n, pool *W ) {
+	/* Returns the number of points given to each task, so that 
+	each thread of W gets one task.
+	*/
+	int threads = pool_threads( W );
+	int chunk = ( n + threads - 1 )/threads;
+	return ( chunk > 0 ) ? chunk : 1;
+}
+
+static int chunk_length( int n, int chunk, int i ) {
+	/* Returns the number of points in task i.
+	*/
+	int len = n - i*chunk;
+	return ( len < chunk ) ? len : chunk;
+}
+
+typedef struct four_iso_job {
+	int n;
+	int chunk; // each task evaluates chunk points.
+	point **pts;
+	fp2 *K1;
+	fp2 *K2;
+	fp2 *K3;
+	point *P2; // if not NULL, kernel of a 2-isogeny done after.
+	mpz_ptr p;
+} four_iso_job;
+
+static void four_iso_task( void *arg, int i ) {
+	four_iso_job *job = (four_iso_job *) arg;
+	point **pts = job->pts + i*job->chunk;
+	int len = chunk_length( job->n, job->chunk, i );
+	four_iso_eval_batch( len, pts, job->K1, job->K2, job->K3, pts, job->p );
+	if( job->P2 != NULL ) {
+		two_iso_eval_batch( len, pts, job->P2, pts, job->p );
+	}
+}
+
+void two_e_iso_strategy( curve *F, int n, point *phiP[n],
+	curve *E, point *S, point *P[n], 
+	int e2, int strategy[], mpz_t p, pool *W ) {
+	/* Sets F as the (2^e2)-isogenous curve, ie F = E/<S>, where S has 
+	order 2^e2 in E, and phiP[i] as the image of P[i], following strategy.
+	The chain is made of 4- or 8-isogenies, as planned by two_chain_step,
+	and of a last 2- or 4-isogeny if needed.
+	The images of the points are computed on the threads of W (if not NULL).
+	S is left unchanged.
+
+	WATCH OUT ! E and F are in AplusC form.
+	*/
+	int b = two_chain_step( e2 );
+	int r = e2 % b; // number of doublings left for the last step.
+	int steps = e2/b;
+	point stack[steps];
+	int index[steps];
+	point *todo[steps+n+1];
+	int top = 0, k = 0;
+
+	for( int i = 0; i < steps; i++ ) {
+		point_init_none( &(stack[i]) );
+	}
+	for( int i = 0; i < n; i++ ) {
+		point_set( phiP[i], P[i] );
+	}
+
+	curve G;
+	curve_init_none(&G);
+	curve_set( &G, E );
+
+	fp2 K1, K2, K3;
+	fp2_init_none(&K1);
+	fp2_init_none(&K2);
+	fp2_init_none(&K3);
+	four_iso_job job = { 0, 0, todo, &K1, &K2, &K3, NULL, p };
+
+	point R, T, U;
+	point_init_none(&R);
+	point_init_none(&T);
+	point_init_none(&U);
+	point_set( &T, S ); // pushed through the chain if r > 0.
+	xDBLe( &R, S, &G, p, r );
+	int h = 0; // R has order 2^( b*( steps-h ) ).
+
+	for( int row = 1; row <= steps; row++ ) {
+		while( h < steps - row ) {
+			point_set( &(stack[top]), &R );
+			index[top++] = h;
+			int m = strategy[k++];
+			xDBLe( &R, &R, &G, p, b*m );
+			h += m;
+		}
+
+		if( b == 2 ) {
+			// Now R has order 4.
+			four_iso_curve( &G, &K1, &K2, &K3, &R, p );
+		}
+		else {
+			// Now R has order 8, its image by the 4-isogeny has order 2.
+			xDBL( &U, &R, &G, p );
+			four_iso_curve( &G, &K1, &K2, &K3, &U, p );
+			four_iso_eval( &R, &K1, &K2, &K3, &R, p );
+			two_iso_curve( &G, &R, p );
+			job.P2 = &R;
+		}
+
+		int count = 0;
+		for( int i = 0; i < top; i++ ) {
+			todo[count++] = &(stack[i]);
+		}
+		for( int i = 0; i < n; i++ ) {
+			todo[count++] = phiP[i];
+		}
+		if( r > 0 ) {
+			todo[count++] = &T;
+		}
+		job.n = count;
+		job.chunk = chunk_size( count, W );
+		pool_run( W, ( count + job.chunk - 1 )/job.chunk, four_iso_task, &job );
+
+		if( top > 0 ) {
+			top--;
+			point_set( &R, &(stack[top]) );
+			h = index[top];
+		}
+	}
+
+	if( r == 1 ) {
+		// Now T has order 2.
+		two_iso_curve( &G, &T, p );
+		two_iso_eval_batch( n, phiP, &T, phiP, p );
+	}
+	else if( r == 2 ) {
+		// Now T has order 4.
+		four_iso_curve( &G, &K1, &K2, &K3, &T, p );
+		four_iso_eval_batch( n, phiP, &K1, &K2, &K3, phiP, p );
+	}
+
+	curve_set( F, &G );
+
+	for( int i = 0; i < steps; i++ ) {
+		point_clear( &(stack[i]) );
+	}
+	fp2_clear(&K1);
+	fp2_clear(&K2);
+	fp2_clear(&K3);
+	curve_clear(&G);
+	point_clear(&R);
+	point_clear(&T);
+	point_clear(&U);
+}
+
+void two_e_iso_without_points( curve *F, curve *E, point *S, 
+	int e2, int strategy[], mpz_t p, pool *W ) {
+	/* Sets F as the (2^e2)-isogenous curve, ie F = E/<S>, for the key 
+	exchange : only the points of the strategy stack are evaluated.
+
+	WATCH OUT ! E and F are in AplusC form.
+	*/
+	two_e_iso_strategy( F, 0, NULL, E, S, NULL, e2, strategy, p, W );
+}
+
+typedef struct three_iso_job {
+	int n;
+	int chunk; // each task evaluates chunk points.
+	point **pts;
+	fp2 *K1;
+	fp2 *K2;
+	mpz_ptr p;
+} three_iso_job;
+
+static void three_iso_task( void *arg, int i ) {
+	three_iso_job *job = (three_iso_job *) arg;
+	point **pts = job->pts + i*job->chunk;
+	three_iso_eval_batch( chunk_length( job->n, job->chunk, i ), pts, 
+		job->K1, job->K2, pts, job->p );
+}
+
+void three_e_iso_strategy( curve *F, int n, point *phiP[n],
+	curve *E, point *S, point *P[n], 
+	int e3, int strategy[], mpz_t p, pool *W ) {
+	/* Sets F as the (3^e3)-isogenous curve, ie F = E/<S>, where S has
+	order 3^e3 in E, and phiP[i] as the image of P[i], following strategy.
+	The images of the points are computed on the threads of W (if not NULL).
+	S is left unchanged.
+
+	WATCH OUT E and F are in the form AplusAmoins !
+	*/
+	int steps = strategy_steps( 3, e3 );
+	point stack[steps];
+	int index[steps];
+	point *todo[steps+n];
+	int top = 0, k = 0;
+
+	for( int i = 0; i < steps; i++ ) {
+		point_init_none( &(stack[i]) );
+	}
+	for( int i = 0; i < n; i++ ) {
+		point_set( phiP[i], P[i] );
+	}
+
+	curve G;
+	curve_init_none(&G);
+	curve_set( &G, E );
+
+	fp2 K1, K2;
+	fp2_init_none(&K1);
+	fp2_init_none(&K2);
+	three_iso_job job = { 0, 0, todo, &K1, &K2, p };
+
+	point R;
+	point_init_none(&R);
+	point_set( &R, S );
+	int h = 0; // R has order 3^( steps-h ).
+
+	for( int row = 1; row <= steps; row++ ) {
+		while( h < steps - row ) {
+			point_set( &(stack[top]), &R );
+			index[top++] = h;
+			int m = strategy[k++];
+			xTPLe( &R, &R, &G, p, m );
+			h += m;
+		}
+		// Now R has order 3.
+		three_iso_curve( &G, &K1, &K2, &R, p );
+
+		int count = 0;
+		for( int i = 0; i < top; i++ ) {
+			todo[count++] = &(stack[i]);
+		}
+		for( int i = 0; i < n; i++ ) {
+			todo[count++] = phiP[i];
+		}
+		job.n = count;
+		job.chunk = chunk_size( count, W );
+		pool_run( W, ( count + job.chunk - 1 )/job.chunk, three_iso_task, &job );
+
+		if( top > 0 ) {
+			top--;
+			point_set( &R, &(stack[top]) );
+			h = index[top];
+		}
+	}
+
+	curve_set( F, &G );
+
+	for( int i = 0; i < steps; i++ ) {
+		point_clear( &(stack[i]) );
+	}
+	fp2_clear(&K1);
+	fp2_clear(&K2);
+	curve_clear(&G);
+	point_clear(&R);
+}
+
+void three_e_iso_without_points( curve *F, curve *E, point *S, 
+	int e3, int strategy[], mpz_t p, pool *W ) {
+	/* Sets F as the (3^e3)-isogenous curve, ie F = E/<S>, for the key 
+	exchange : only the points of the strategy stack are evaluated.
+
+	WATCH OUT E and F are in the form AplusAmoins !
+	*/
+	three_e_iso_strategy( F, 0, NULL, E, S, NULL, e3, strategy, p, W );
+}
+
+typedef struct odd_iso_job {
+	point **pts;
+	int d;
+	point *ker;
+	sqrt_velu *V;
+	mpz_ptr p;
+} odd_iso_job;
+
+static void odd_iso_task( void *arg, int i ) {
+	odd_iso_job *job = (odd_iso_job *) arg;
+	if( job->V != NULL ) {
+		sqrt_velu_eval( job->pts[i], job->V, job->pts[i], job->p );
+	}
+	else {
+		odd_isogeny( job->pts[i], job->d, job->ker, job->pts[i], job->p );
+	}
+}
+
+static void odd_iso_step( curve *G, point *Beta, int count, point *todo[count],
+	point *K, int l, int codomain, mpz_t p, pool *W ) {
+	/* Sets G as G/<K> if codomain is set, where K has odd order l, and 
+	pushes the count points of todo through the isogeny (Beta is the last 
+	one if not NULL).
+	The curve is recovered from Beta if not NULL, from the kernel otherwise.
+	*/
+	int d = ( l-1 )/2;
+	point ker[d];
+	odd_iso_job job = { todo, d, ker, NULL, p };
+
+	sqrt_velu V;
+	int fast = sqrt_velu_is_faster( l, count+1 );
+	if( fast ) {
+		sqrt_velu_init( &V, l, K, G, p );
+		job.V = &V;
+	}
+	else {
+		for( int i = 0; i < d; i++ ) {
+			point_init_none( &(ker[i]) );
+		}
+		kernel_point( d, ker, K, G, p );
+		kernel_reshape( d, ker, p );
+	}
+
+	pool_run( W, count, odd_iso_task, &job );
+
+	if( codomain && Beta != NULL ) {
+		curve_from_Alpha( G, Beta, p );
+	}
+	else if( codomain && fast ) {
+		sqrt_velu_curve( G, &V, p );
+	}
+	else if( codomain ) {
+		odd_iso_curve( G, d, ker, G, p );
+	}
+
+	if( fast ) {
+		sqrt_velu_clear( &V );
+	}
+	else {
+		for( int i = 0; i < d; i++ ) {
+			point_clear( &(ker[i]) );
+		}
+	}
+}
+
 void simultaneous_odd_isogeny( point *R, point *Beta, 
 	point *S1, point *S2, point *S3,
 	point *G, curve *F, point *P, point *Q, point *QminusP, 
@@ -349,31 +1401,27 @@ void simultaneous_odd_isogeny( point *R, point *Beta,
 	the two torsion point Beta as phi(Beta),
 	S1 as phi(P), S2 as phi(Q), S3 as phi(QminusP),
 	where phi is an odd isogeny with degree 2d+1 and kernel <G>.
+	Kept for the callers of the first version : odd_e_iso_strategy runs
+	the same step along the whole chain.
 
 	WATCH OUT ! F is in the form ( A+2C : 4C ) !
 	*/
+	simultaneous_odd_isogeny_pool( R, Beta, S1, S2, S3, 
+		G, F, P, Q, QminusP, p, d, NULL );
+}
+
+void simultaneous_odd_isogeny_pool( point *R, point *Beta, 
+	point *S1, point *S2, point *S3,
+	point *G, curve *F, point *P, point *Q, point *QminusP, 
+	mpz_t p, int d, pool *W ) {
+	/* Same as simultaneous_odd_isogeny, with the five images computed on 
+	the threads of W (if not NULL).
+	*/
 	point_set( S1, P );
 	point_set( S2, Q );
 	point_set( S3, QminusP );
-
-	point ker[d];
-	for( int i = 0; i<d; i++ ) {
-	 	point_init_none( &(ker[i]) );
-	}
-	kernel_point( d, ker, G, F, p );
-
-	kernel_reshape( d, ker, p );
-	// Now (Xi : Zi) = (Xi+Zi : Xi-Zi).
-	
-	odd_isogeny( R, d, ker, R, p );
-	odd_isogeny( Beta, d, ker, Beta, p );	
-	odd_isogeny( S1, d, ker, S1, p ); 
-	odd_isogeny( S2, d, ker, S2, p );
-	odd_isogeny( S3, d, ker, S3, p );
-
-	for( int i = 0; i<d; i++ ) {
-		point_clear( &(ker[i]) );
-	}
+	point *todo[5] = { R, Beta, S1, S2, S3 };
+	odd_iso_step( F, NULL, 5, todo, G, 2*d+1, 0, p, W );
 }
 
 void simultaneous_odd_isogeny_without_points( point *R, point *Beta, 
@@ -384,24 +1432,87 @@ void simultaneous_odd_isogeny_without_points( point *R, point *Beta,
 
 	WATCH OUT ! F is in the form ( A+2C : 4C ) !
 	*/
-	point ker[d];
-	for( int i = 0; i<d; i++ ) {
-		point_init_none( &(ker[i]) );
+	point *todo[2] = { R, Beta };
+	odd_iso_step( F, NULL, 2, todo, G, 2*d+1, 0, p, NULL );
+}
+
+void odd_e_iso_strategy( curve *F, point *Beta, int n, point *phiP[n],
+	curve *E, point *S, point *P[n], 
+	int l, int e, int strategy[], mpz_t p, pool *W ) {
+	/* Sets F as the (l^e)-isogenous curve, ie F = E/<S>, where S has
+	order l^e in E, and phiP[i] as the image of P[i], following strategy.
+	The images of the points are computed on the threads of W (if not NULL).
+
+	If Beta is not NULL, it is a two torsion point of E, pushed through 
+	each isogeny, and each curve is recovered from it with curve_from_Alpha.
+	Otherwise, each curve is computed from the kernel with odd_iso_curve.
+	S is left unchanged.
+
+	WATCH OUT ! E and F are in the form ( A+2C : 4C ) !
+	*/
+	int steps = strategy_steps( l, e );
+	point stack[steps];
+	int index[steps];
+	point *todo[steps+n+1];
+	int top = 0, next = 0;
+
+	for( int i = 0; i < steps; i++ ) {
+		point_init_none( &(stack[i]) );
+	}
+	for( int i = 0; i < n; i++ ) {
+		point_set( phiP[i], P[i] );
 	}
-	kernel_point( d, ker, G, F, p );
 
-	kernel_reshape( d, ker, p );
-	// Now (Xi : Zi) = (Xi+Zi : Xi-Zi).
-	
-	odd_isogeny( R, d, ker, R, p );
-	odd_isogeny( Beta, d, ker, Beta, p );	
+	curve G;
+	curve_init_none(&G);
+	curve_set( &G, E );
 
-	for( int i = 0; i<d; i++ ) {
-		point_clear( &(ker[i]) );
+	mpz_t q;
+	mpz_init( q );
+	point R;
+	point_init_none(&R);
+	point_set( &R, S );
+	int h = 0; // R has order l^( steps-h ).
+
+	for( int row = 1; row <= steps; row++ ) {
+		while( h < steps - row ) {
+			point_set( &(stack[top]), &R );
+			index[top++] = h;
+			int m = strategy[next++];
+			mpz_ui_pow_ui( q, l, m );
+			Ladder( &R, &R, &G, q, p );
+			h += m;
+		}
+		// Now R has order l.
+
+		int count = 0;
+		for( int i = 0; i < top; i++ ) {
+			todo[count++] = &(stack[i]);
+		}
+		for( int i = 0; i < n; i++ ) {
+			todo[count++] = phiP[i];
+		}
+		if( Beta != NULL ) {
+			todo[count++] = Beta;
+		}
+		odd_iso_step( &G, Beta, count, todo, &R, l, 1, p, W );
+
+		if( top > 0 ) {
+			top--;
+			point_set( &R, &(stack[top]) );
+			h = index[top];
+		}
 	}
-}
 
+	curve_set( F, &G );
 
+	for( int i = 0; i < steps; i++ ) {
+		point_clear( &(stack[i]) );
+	}
+	mpz_clear( q );
+	curve_clear(&G);
+	point_clear(&R);
+}
 
 // Main is only for testing. Uncomment to run the tests on these functions.
 /*
@@ -410,7 +1521,6 @@ int main(int argc, char const *argv[])
 	curve E, F;
 	point G;
 	point P, S;
-	point R, S1, S2, S3, Beta;
 	
 	// --------------------- TESTS ODD PRIMES ---------------//
 	printf("TESTS ODD PRIMES : \n");
@@ -454,44 +1564,6 @@ int main(int argc, char const *argv[])
 	point_normalize( &S, &S, p );
 	point_print( &S );
 
-	printf("Simultaneous odd isogeny test : \n");
-	printf("Should return (0 : 0), (16 + 7i : 1), (18 : 1)\n");
-	point_init_none( &R );
-	point_set( &R, &G );
-	point_init_ui( &Beta, 0, 1, 1, 0, p ); // Beta = (0 : 0 : 1)
-	point_init_none( &S1 );
-	point_init_none( &S2 );
-	point_init_none( &S3 );
-	
-	simultaneous_odd_isogeny(  &R, &Beta, &S1, &S2, &S3,
-		&G, &F, &P, &P, &P, p, d );
-
-	point_normalize( &R, &R, p );
-	point_normalize( &Beta, &Beta, p ); 
-	point_normalize( &S2, &S2, p );
-	point_print( &R );
-	point_print( &Beta );
-	point_print( &S2 );
-
-	printf("Simultaneous odd isogeny without point test : \n");
-	printf("Should return (0 : 0), (16 + 7i : 1)\n");
-	point_set( &R, &G );
-	point_clear(&Beta);
-	point_init_ui( &Beta, 0, 1, 1, 0, p ); // Beta = (0 : 0 : 1)
-	
-	simultaneous_odd_isogeny_without_points(  &R, &Beta,
-		&G, &F, p, d );
-
-	point_normalize( &R, &R, p );
-	point_normalize( &Beta, &Beta, p ); 
-	point_print( &R );
-	point_print( &Beta );
-
-	point_clear(&Beta);
-	point_clear(&S3);
-	point_clear(&S2);
-	point_clear(&S1);
-	point_clear(&R);
 	point_clear(&S);
 	point_clear(&P);
 	for( int i = 0; i<d; i++ ) {
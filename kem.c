@@ -0,0 +1,278 @@
+/*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*
+*
+* Contains the key encapsulation mechanism built on the key
+* generation and exchange of pk_sk_param.c, as in SIKE : the
+* encryption scheme hashes the j invariant with SHAKE256, and
+* the Fujisaki-Okamoto transform re-encrypts on decapsulation.
+* Side B holds the long term key and side A encapsulates, with
+* the 2/3 functions or the generalized ones depending on pA.
+*
+*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <gmp.h>
+#include "Header.h"
+
+/* --------------------------------------------------------
+ 					HASHING
+----------------------------------------------------------*/
+
+static void secret_from_bytes( mpz_t s, unsigned char *in, size_t len, int l, int e ) {
+	/* Sets s as the integer given by the len bytes of in, little endian,
+	reduced mod l^e.
+	*/
+	mpz_import( s, len, -1, 1, 0, 0, in );
+	if( l == 2 ) {
+		mpz_tdiv_r_2exp( s, s, e );
+	}
+	else {
+		mpz_t q;
+		mpz_init( q );
+		mpz_ui_pow_ui( q, l, e );
+		mpz_mod( s, s, q );
+		mpz_clear( q );
+	}
+}
+
+static size_t secret_bytes( int l, int e ) {
+	/* Returns the number of bytes to draw for a secret mod l^e : exactly
+	e bits for l = 2, and 64 more bits than l^e otherwise, so that the
+	bias of the reduction is negligible.
+	*/
+	if( l == 2 ) {
+		return ( e + 7 )/8;
+	}
+	mpz_t q;
+	mpz_init( q );
+	mpz_ui_pow_ui( q, l, e );
+	size_t n = ( mpz_sizeinbase( q, 2 ) + 64 + 7 )/8;
+	mpz_clear( q );
+	return n;
+}
+
+static void hash_secret( mpz_t r, unsigned char m[KEM_BYTES], pk *PK,
+	int l, int e, parameters *param ) {
+	/* G : sets r as SHAKE256( m || PK ) mod l^e, with PK as in pk_encode.
+	*/
+	size_t n = pk_bytes( param );
+	size_t len = secret_bytes( l, e );
+	unsigned char *buf = malloc( KEM_BYTES + n );
+	unsigned char *out = malloc( len );
+	memcpy( buf, m, KEM_BYTES );
+	pk_encode( buf + KEM_BYTES, PK, param );
+	shake256( out, len, buf, KEM_BYTES + n );
+	secret_from_bytes( r, out, len, l, e );
+	free( buf );
+	free( out );
+}
+
+static void hash_j( unsigned char h[KEM_BYTES], fp2 *j, parameters *param ) {
+	/* F : sets h as SHAKE256( j ).
+	*/
+	size_t len = 2*fp_bytes( param->p );
+	unsigned char *buf = malloc( len );
+	fp2_encode( buf, j, param->p );
+	shake256( h, KEM_BYTES, buf, len );
+	free( buf );
+}
+
+static void hash_key( unsigned char K[KEM_BYTES], unsigned char m[KEM_BYTES],
+	unsigned char *c0, size_t n, unsigned char c1[KEM_BYTES] ) {
+	/* H : sets K as SHAKE256( m || c0 || c1 ), with c0 of n bytes.
+	*/
+	unsigned char *buf = malloc( 2*KEM_BYTES + n );
+	memcpy( buf, m, KEM_BYTES );
+	memcpy( buf + KEM_BYTES, c0, n );
+	memcpy( buf + KEM_BYTES + n, c1, KEM_BYTES );
+	shake256( K, KEM_BYTES, buf, 2*KEM_BYTES + n );
+	free( buf );
+}
+
+/* --------------------------------------------------------
+ 					SIDES
+----------------------------------------------------------*/
+
+static void kem_isogen_A( pk *PKA, sk *SKA, parameters *param ) {
+	/* Key generation of the side A, 2 or pA.
+	*/
+	if( param->pA == 2 ) {
+		isogen_two( PKA, SKA, param );
+	}
+	else {
+		isogen_Alice( PKA, SKA, param );
+	}
+}
+
+static void kem_isogen_B( pk *PKB, sk *SKB, parameters *param ) {
+	/* Key generation of the side B, 3 or pB.
+	*/
+	if( param->pA == 2 ) {
+		isogen_three( PKB, SKB, param );
+	}
+	else {
+		isogen_Bob( PKB, SKB, param );
+	}
+}
+
+static void kem_isoex_A( fp2 *j, sk *SKA, pk *PKB, parameters *param ) {
+	/* Key exchange of the side A, with the public key PKB.
+	*/
+	if( param->pA == 2 ) {
+		isoex_two( j, SKA, PKB, param );
+	}
+	else {
+		isoex_Alice( j, PKB, SKA, param );
+	}
+}
+
+static void kem_isoex_B( fp2 *j, sk *SKB, pk *PKA, parameters *param ) {
+	/* Key exchange of the side B, with the public key PKA.
+	*/
+	if( param->pA == 2 ) {
+		isoex_three( j, SKB, PKA, param );
+	}
+	else {
+		isoex_Bob( j, PKA, SKB, param );
+	}
+}
+
+/* --------------------------------------------------------
+ 					KEYS AND CIPHERTEXTS
+----------------------------------------------------------*/
+
+void kem_sk_init_none( kem_sk *SK ) {
+	/* Initializes SK with value 0 for every fields.
+	*/
+	memset( SK->s, 0, KEM_BYTES );
+	mpz_init( SK->SK.secret );
+	pk_init_none( &(SK->PK) );
+}
+
+void kem_sk_clear( kem_sk *SK ) {
+	/* Clears the fields of SK, and erases s.
+	*/
+	memset( SK->s, 0, KEM_BYTES );
+	sk_clear( &(SK->SK) );
+	pk_clear( &(SK->PK) );
+}
+
+void kem_ct_init_none( kem_ct *C ) {
+	/* Initializes C with value 0 for every fields.
+	*/
+	pk_init_none( &(C->c0) );
+	memset( C->c1, 0, KEM_BYTES );
+}
+
+void kem_ct_clear( kem_ct *C ) {
+	/* Clears the fields of C.
+	*/
+	pk_clear( &(C->c0) );
+}
+
+/* --------------------------------------------------------
+ 					KEM
+----------------------------------------------------------*/
+
+void kem_keygen( pk *PK, kem_sk *SK, parameters *param ) {
+	/* Key generation of the KEM, on the side B.
+	Sets SK with a random secret and PK as its public key.
+	*/
+	random_secret( SK->SK.secret, param->pB, param->eB, NULL );
+	random_bytes( SK->s, KEM_BYTES );
+
+	kem_isogen_B( PK, &(SK->SK), param );
+	fp2_set( &(SK->PK.beta), &(PK->beta) );
+	fp2_set( &(SK->PK.x1), &(PK->x1) );
+	fp2_set( &(SK->PK.x2), &(PK->x2) );
+	fp2_set( &(SK->PK.x3), &(PK->x3) );
+	fp2_set( &(SK->PK.A), &(PK->A) );
+	SK->PK.extended = PK->extended;
+}
+
+static void kem_encrypt( kem_ct *C, unsigned char m[KEM_BYTES], pk *PK,
+	parameters *param ) {
+	/* Encrypts m with the ephemeral secret G( m || PK ) on the side A :
+	C = ( c0, c1 ) = ( public key, m xor F( j ) ).
+	*/
+	sk SKA;
+	mpz_init( SKA.secret );
+	hash_secret( SKA.secret, m, PK, param->pA, param->eA, param );
+	kem_isogen_A( &(C->c0), &SKA, param );
+
+	fp2 j;
+	fp2_init_none( &j );
+	kem_isoex_A( &j, &SKA, PK, param );
+	hash_j( C->c1, &j, param );
+	for( int i = 0; i < KEM_BYTES; i++ ) {
+		C->c1[i] ^= m[i];
+	}
+	fp2_clear( &j );
+	sk_clear( &SKA );
+}
+
+void kem_encaps( unsigned char K[KEM_BYTES], kem_ct *C, pk *PK, parameters *param ) {
+	/* Encapsulation of the KEM, on the side A.
+	Sets C as a ciphertext for the public key PK, and K as the shared secret.
+	*/
+	unsigned char m[KEM_BYTES];
+	random_bytes( m, KEM_BYTES );
+	kem_encrypt( C, m, PK, param );
+
+	size_t n = pk_bytes( param );
+	unsigned char *c0 = malloc( n );
+	pk_encode( c0, &(C->c0), param );
+	hash_key( K, m, c0, n, C->c1 );
+	memset( m, 0, KEM_BYTES );
+	free( c0 );
+}
+
+void kem_decaps( unsigned char K[KEM_BYTES], kem_ct *C, kem_sk *SK, parameters *param ) {
+	/* Decapsulation of the KEM, on the side B.
+	Sets K as the shared secret of C if re-encrypting the decrypted message
+	gives back C, and as a hash of the secret SK->s otherwise.
+	*/
+	unsigned char m[KEM_BYTES];
+	fp2 j;
+	fp2_init_none( &j );
+	kem_isoex_B( &j, &(SK->SK), &(C->c0), param );
+	hash_j( m, &j, param );
+	for( int i = 0; i < KEM_BYTES; i++ ) {
+		m[i] ^= C->c1[i];
+	}
+
+	kem_ct D;
+	kem_ct_init_none( &D );
+	kem_encrypt( &D, m, &(SK->PK), param );
+
+	// The ciphertexts are compared on their encodings only : the
+	// coefficient A of an extended c0 is a local shortcut, and is not
+	// part of the ciphertext. The comparison does not stop at the first
+	// difference.
+	size_t n = pk_bytes( param );
+	unsigned char *c0 = malloc( n );
+	unsigned char *d0 = malloc( n );
+	pk_encode( c0, &(C->c0), param );
+	pk_encode( d0, &(D.c0), param );
+	unsigned char diff = 0;
+	for( size_t i = 0; i < n; i++ ) {
+		diff |= c0[i] ^ d0[i];
+	}
+	for( int i = 0; i < KEM_BYTES; i++ ) {
+		diff |= C->c1[i] ^ D.c1[i];
+	}
+
+	// mask = 0xff if the ciphertexts are equal, 0 otherwise.
+	unsigned char mask = ( (unsigned int) diff - 1 ) >> 8;
+	for( int i = 0; i < KEM_BYTES; i++ ) {
+		m[i] = ( m[i] & mask ) | ( SK->s[i] & ~mask );
+	}
+	hash_key( K, m, c0, n, C->c1 );
+
+	memset( m, 0, KEM_BYTES );
+	free( c0 );
+	free( d0 );
+	kem_ct_clear( &D );
+	fp2_clear( &j );
+}
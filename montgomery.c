@@ -53,51 +53,56 @@ void xADD( point *A, point *P, point *Q, point *R, mpz_t p ) {
 
 }
 
+static void xDBL_step( point *R, point *P, curve *F, mpz_t p, fp2 t[2] ) {
+	/* Sets R = 2P on group F, with the temporaries t given by the caller.
+	R can be P.
+
+	WATCH OUT ! F has to be in the form AplusC = (A+2C : 4C).
+	*/
+	fp2_sub( &(t[0]), &(P->X), &(P->Z), p );
+	fp2_add( &(t[1]), &(P->X), &(P->Z), p );
+	fp2_mult( &(t[0]), &(t[0]), &(t[0]), p );
+	fp2_mult( &(t[1]), &(t[1]), &(t[1]), p );
+	fp2_mult( &(R->Z), &(F->C), &(t[0]), p );
+	fp2_mult( &(R->X), &(R->Z), &(t[1]), p );
+	fp2_sub( &(t[1]), &(t[1]), &(t[0]), p );
+	fp2_mult( &(t[0]), &(F->A), &(t[1]), p );
+	fp2_add( &(R->Z), &(R->Z), &(t[0]), p );
+	fp2_mult( &(R->Z), &(R->Z), &(t[1]), p );
+}
+
 void xDBL( point *R, point *P, curve *F, mpz_t p ) {
 	/* Sets R = 2P on group F.
 
 	WATCH OUT ! F has to be in the form AplusC = (A+2C : 4C).
 	*/
-	fp2 t0, t1;
-	fp2_init_none(&(t0));
-	fp2_init_none(&(t1));
-	point T;
-	point_init_none(&T);
-	
-	fp2_sub( &t0, &(P->X), &(P->Z), p );
-	fp2_add( &t1, &(P->X), &(P->Z), p );
-	fp2_mult( &t0, &t0, &t0, p );
-	fp2_mult(&t1, &t1, &t1, p );
-	fp2_mult( &(T.Z), &(F->C), &t0, p );
-	fp2_mult( &(T.X), &(T.Z), &t1, p );
-	fp2_sub( &t1, &t1, &t0, p );
-	fp2_mult( &t0, &(F->A), &t1, p );
-	fp2_add( &(T.Z), &(T.Z), &t0, p );
-	fp2_mult( &(T.Z), &(T.Z), &t1, p );
-
-	point_set( R, &T );
-	
-	point_clear(&T);
-	fp2_clear(&t0);
-	fp2_clear(&t1);
+	fp2 t[2];
+	fp2_init_none(&(t[0]));
+	fp2_init_none(&(t[1]));
+
+	xDBL_step( R, P, F, p, t );
+
+	fp2_clear(&(t[0]));
+	fp2_clear(&(t[1]));
 }
 
 void xDBLe( point *R, point *P, curve *F, mpz_t p, int e ) {
-	/* Sets R = 2^eP on group F.
+	/* Sets R = 2^eP on group F. The doublings are done in place in R,
+	with the same temporaries.
 
 	WATCH OUT ! F has to be in the form AplusC = (A+2C : 4C).
 	*/
+	fp2 t[2];
+	fp2_init_none(&(t[0]));
+	fp2_init_none(&(t[1]));
 
-	point T;
-	point_init_none(&T);
-
-	point_set( &T, P );
+	point_set( R, P );
 	for( int i=0; i < e; i++ ) {
-		xDBL( &T, &T, F, p );
+		xDBL_step( R, R, F, p, t );
 	}
 
-	point_set( R, &T );
-	point_clear(&T);
+	fp2_clear(&(t[0]));
+	fp2_clear(&(t[1]));
 }
 
 void xDBLADD( point * twoP, point *PplusQ,
@@ -146,72 +151,79 @@ void xDBLADD( point * twoP, point *PplusQ,
 	fp2_clear(&t2);
 }
 
+static void xTPL_step( point *R, point *P, curve *F, mpz_t p, fp2 t[7] ) {
+	/* Sets R = 3P on group F, with the temporaries t given by the caller.
+	R can be P.
+
+	WATCH OUT ! F has to be in the form AplusAminus.
+	*/
+	fp2 *t0 = &(t[0]), *t1 = &(t[1]), *t2 = &(t[2]), *t3 = &(t[3]);
+	fp2 *t4 = &(t[4]), *t5 = &(t[5]), *t6 = &(t[6]);
+
+	fp2_sub( t0, &(P->X), &(P->Z), p );
+	fp2_mult( t2, t0, t0, p );
+	fp2_add( t1, &(P->X), &(P->Z), p );
+	fp2_mult( t3, t1, t1, p );
+	fp2_add( t4, t1, t0, p );
+	fp2_sub( t0, t1, t0, p );
+
+	fp2_mult( t1, t4, t4, p );
+	fp2_sub( t1, t1, t3, p );
+	fp2_sub( t1, t1, t2, p );
+	fp2_mult( t5, t3, &(F->A), p );
+	fp2_mult( t3, t5, t3, p );
+	fp2_mult( t6, t2, &(F->C), p );
+
+	fp2_mult( t2, t2, t6, p );
+	fp2_sub( t3, t2, t3, p );
+	fp2_sub( t2, t5, t6, p );
+	fp2_mult( t1, t2, t1, p );
+	fp2_add( t2, t3, t1, p );
+	fp2_mult( t2, t2, t2, p );
+
+	fp2_mult( &(R->X), t2, t4, p );
+	fp2_sub( t1, t3, t1, p );
+	fp2_mult( t1, t1, t1, p );
+	fp2_mult( &(R->Z), t1, t0, p );
+}
+
 void xTPL( point *R, point *P, curve *F, mpz_t p ) {
 	/*
 	Sets R = 3P on group F.
 
 	WATCH OUT ! F has to be in the form AplusAminus.
 	*/
-	fp2 t0, t1, t2, t3, t4, t5, t6;
-	fp2_init_none(&t0);
-	fp2_init_none(&t1);
-	fp2_init_none(&t2);
-	fp2_init_none(&t3);
-	fp2_init_none(&t4);
-	fp2_init_none(&t5);
-	fp2_init_none(&t6);
-
-	fp2_sub( &t0, &(P->X), &(P->Z), p );
-	fp2_mult( &t2, &t0, &t0, p );
-	fp2_add( &t1, &(P->X), &(P->Z), p );
-	fp2_mult( &t3, &t1, &t1, p );
-	fp2_add( &t4, &t1, &t0, p );
-	fp2_sub( &t0, &t1, &t0, p );
-
-	fp2_mult( &t1, &t4, &t4, p );
-	fp2_sub( &t1, &t1, &t3, p );
-	fp2_sub( &t1, &t1, &t2, p );
-	fp2_mult( &t5, &t3, &(F->A), p );
-	fp2_mult( &t3, &t5, &t3, p );
-	fp2_mult( &t6, &t2, &(F->C), p );
-
-	fp2_mult( &t2, &t2, &t6, p );
-	fp2_sub( &t3, &t2, &t3, p );
-	fp2_sub( &t2, &t5, &t6, p );
-	fp2_mult( &t1, &t2, &t1, p );
-	fp2_add( &t2, &t3, &t1, p );
-	fp2_mult( &t2, &t2, &t2, p );
+	fp2 t[7];
+	for( int i = 0; i < 7; i++ ) {
+		fp2_init_none( &(t[i]) );
+	}
 
-	fp2_mult( &(R->X), &t2, &t4, p );
-	fp2_sub( &t1, &t3, &t1, p );
-	fp2_mult( &t1, &t1, &t1, p );
-	fp2_mult( &(R->Z), &t1, &t0, p );
+	xTPL_step( R, P, F, p, t );
 
-	fp2_clear(&t0);
-	fp2_clear(&t1);
-	fp2_clear(&t2);
-	fp2_clear(&t3);
-	fp2_clear(&t4);
-	fp2_clear(&t5);
-	fp2_clear(&t6);
+	for( int i = 0; i < 7; i++ ) {
+		fp2_clear( &(t[i]) );
+	}
 }
 
 void xTPLe( point *R, point *P, curve *F, mpz_t p, int e ) {
-	/* Sets R = 3eP on group F.
+	/* Sets R = 3eP on group F. The triplings are done in place in R,
+	with the same temporaries.
 
 	WATCH OUT ! F has to be in the form AplusAminus.
 	*/
-	point T;
-	point_init_none(&T);
+	fp2 t[7];
+	for( int i = 0; i < 7; i++ ) {
+		fp2_init_none( &(t[i]) );
+	}
 
-	point_set( &T, P );
+	point_set( R, P );
 	for( int i=0; i < e; i++ ) {
-		xTPL( &T, &T, F, p );
+		xTPL_step( R, R, F, p, t );
 	}
 
-	point_set( R, &T );
-	point_clear(&T);
-
+	for( int i = 0; i < 7; i++ ) {
+		fp2_clear( &(t[i]) );
+	}
 }
 
 void Ladder( point *R, point *P, curve *F, mpz_t m, mpz_t p ) {
@@ -332,53 +344,216 @@ void Ladder3pt_without_conversion( point *QplusmP, mpz_t m,
 	curve_clear(&G);
 }
 
+fp2 *ladder_table_new( int n, fp2 *xQ, curve *F, mpz_t p ) {
+	/* Returns the table of the x([2^i]Q) - 1 and x([2^i]Q) + 1, at 2i and
+	2i+1, for 0 <= i < n, normalized with a single inversion. The table
+	has to be freed with ladder_table_free.
+
+	WATCH OUT ! F has to be in the form ( A+2C : 4C ), and none of 
+	the [2^i]Q can be the point at infinity.
+	*/
+	if( n < 1 ) {
+		return NULL;
+	}
+	point T;
+	point_init_normalize( &T, xQ, p );
+	fp2 *table = malloc( 2*n*sizeof( fp2 ) );
+	fp2 Z[n];
+	for( int i = 0; i < n; i++ ) {
+		fp2_init_none( &(table[2*i]) );
+		fp2_init_none( &(table[2*i+1]) );
+		fp2_init_none( &(Z[i]) );
+		fp2_set( &(table[2*i]), &(T.X) );
+		fp2_set( &(Z[i]), &(T.Z) );
+		xDBL( &T, &T, F, p );
+	}
+
+	fp2_batch_multinv( n, Z, Z, p );
+	for( int i = 0; i < n; i++ ) {
+		fp2 *x = &(table[2*i]);
+		fp2_mult( x, x, &(Z[i]), p );
+		fp2_set( &(table[2*i+1]), x );
+		mpz_sub_ui( table[2*i].s0, table[2*i].s0, 1 );
+		mpz_mod( table[2*i].s0, table[2*i].s0, p );
+		mpz_add_ui( table[2*i+1].s0, table[2*i+1].s0, 1 );
+		mpz_mod( table[2*i+1].s0, table[2*i+1].s0, p );
+		fp2_clear( &(Z[i]) );
+	}
+	point_clear( &T );
+	return table;
+}
+
+void ladder_table_free( int n, fp2 *table ) {
+	/* Frees a table given by ladder_table_new.
+	*/
+	if( table == NULL ) {
+		return;
+	}
+	for( int i = 0; i < 2*n; i++ ) {
+		fp2_clear( &(table[i]) );
+	}
+	free( table );
+}
+
+static void xADD_affine( point *A, fp2 xP[2], point *Q, point *R, mpz_t p, fp2 t[4] ) {
+	/* Same as xADD, with P = (x : 1) given by xP = { x-1, x+1 } and the 
+	temporaries t given by the caller. A can be Q.
+	*/
+	fp2 *t1 = &(t[0]), *t2 = &(t[1]), *t3 = &(t[2]), *t4 = &(t[3]);
+
+	fp2_add( t2, &(Q->X), &(Q->Z), p );
+	fp2_mult( t3, &(xP[0]), t2, p );
+
+	fp2_sub( t2, &(Q->X), &(Q->Z), p );
+	fp2_mult( t4, &(xP[1]), t2, p );
+
+	fp2_add( t1, t3, t4, p );
+	fp2_mult( t1, t1, t1, p );
+	fp2_mult( &(A->X), t1, &(R->Z), p );
+
+	fp2_sub( t2, t3, t4, p );
+	fp2_mult( t2, t2, t2, p );
+	fp2_mult( &(A->Z), t2, &(R->X), p );
+}
+
+int Ladder3pt_table( point *QplusmP, mpz_t m, 
+	fp2 *xP, int n, fp2 table[2*n], fp2 *xQminusP, mpz_t p ) {
+	/* Same as Ladder3pt, where table holds the abscissas of the [2^i]Q,
+	minus and plus 1, given by ladder_table_new : the doublings of Q are 
+	read from the table, and each bit of m only costs a differential 
+	addition, with the temporaries allocated once.
+	Returns 0, without setting QplusmP, if m has more than n bits.
+	*/
+	size_t l;
+	l = mpz_sizeinbase ( m, 2 );
+	if( table == NULL || l > n ) {
+		return 0;
+	}
+
+	point P1, P2;
+	point_init_normalize( &P1, xP, p );
+	point_init_normalize( &P2, xQminusP, p );
+
+	fp2 t[4];
+	for( int i = 0; i < 4; i++ ) {
+		fp2_init_none( &(t[i]) );
+	}
+
+	for( int i=0; i< (l); i++ ) {
+		// Invariant : P1 - P2 = [2^i]Q, up to sign.
+		if( mpz_tstbit( m, i ) ) { 
+			xADD_affine( &P1, &(table[2*i]), &P1, &P2, p, t );
+		}
+		else{
+			xADD_affine( &P2, &(table[2*i]), &P2, &P1, p, t );
+		}
+	}
+	point_set( QplusmP, &P1 );
+
+	for( int i = 0; i < 4; i++ ) {
+		fp2_clear( &(t[i]) );
+	}
+	point_clear(&P1);
+	point_clear(&P2);
+	return 1;
+}
+
 /* --------------------------------------------------------
                 		TOOLS PART
 ----------------------------------------------------------*/
 
-void jInvariant( fp2 *j, curve *E, mpz_t p ) {
-	/* Returns j invariant from curve E.
+static void j_fraction( fp2 *num, fp2 *den, curve *E, mpz_t p ) {
+	/* Sets num and den such that the j invariant of E is num/den.
 	*/
-	fp2 tmp, t0, t1;
-	fp2_init_none(&tmp);
+	fp2 t0, t1;
 	fp2_init_none(&t0);
 	fp2_init_none(&t1);
 
-	fp2_mult( &tmp, &(E->A), &(E->A), p );
+	fp2_mult( den, &(E->A), &(E->A), p );
 	fp2_mult( &t1, &(E->C), &(E->C), p );
 	fp2_add( &t0, &t1, &t1, p );
-	fp2_sub( &t0, &tmp, &t0, p );
+	fp2_sub( &t0, den, &t0, p );
 	fp2_sub( &t0, &t0, &t1, p );
 
-	fp2_sub( &tmp, &t0, &t1, p );
+	fp2_sub( den, &t0, &t1, p );
 	fp2_mult( &t1, &t1, &t1, p );
-	fp2_mult( &tmp, &tmp, &t1, p );
+	fp2_mult( den, den, &t1, p );
 	fp2_add( &t0, &t0, &t0, p );
 	fp2_add( &t0, &t0, &t0, p );
 
 	fp2_mult( &t1, &t0, &t0, p );
 	fp2_mult( &t0, &t0, &t1, p );
 	fp2_add( &t0, &t0, &t0, p );
-	fp2_add( &t0, &t0, &t0, p );
-	fp2_multinv( &tmp, &tmp, p );
+	fp2_add( num, &t0, &t0, p );
+
+	fp2_clear(&t0);
+	fp2_clear(&t1);
+}
+
+void jInvariant( fp2 *j, curve *E, mpz_t p ) {
+	/* Returns j invariant from curve E.
+	*/
+	fp2 num, den;
+	fp2_init_none(&num);
+	fp2_init_none(&den);
 
-	fp2_mult( &tmp, &t0, &tmp, p );
+	j_fraction( &num, &den, E, p );
+	fp2_multinv( &den, &den, p );
+	fp2_mult( j, &num, &den, p );
 
-	fp2_set( j, &tmp );
+	fp2_clear(&num);
+	fp2_clear(&den);
+}
+
+void jInvariant_projective( fp2 *num, fp2 *den, curve *E, mpz_t p ) {
+	/* Sets ( num : den ) as the j invariant of curve E, without inversion.
+	*/
+	j_fraction( num, den, E, p );
+}
+
+int j_are_equal( fp2 *num1, fp2 *den1, fp2 *num2, fp2 *den2, mpz_t p ) {
+	/* Returns 1 if the j invariants ( num1 : den1 ) and ( num2 : den2 )
+	are equal, ie num1*den2 = num2*den1, and 0 otherwise.
+	*/
+	fp2 t1, t2;
+	fp2_init_none(&t1);
+	fp2_init_none(&t2);
+
+	fp2_mult( &t1, num1, den2, p );
+	fp2_mult( &t2, num2, den1, p );
+	int same = fp2_are_equal( &t1, &t2 ) 
+		&& !fp2_is_zero( den1, p ) && !fp2_is_zero( den2, p );
 
-	fp2_clear(&tmp);
-	fp2_clear(&t0);
 	fp2_clear(&t1);
+	fp2_clear(&t2);
+	return same;
 }
 
-void get_A( fp2 *A, fp2 *xP, fp2 *xQ, fp2 *xQminusP, mpz_t p ) {
-	/* Sets A as the first parameter of a curve passing through
-	xP, xQ and x(Q-P).
+void jInvariant_batch( int n, fp2 j[n], curve E[n], mpz_t p ) {
+	/* Sets j[i] as the j invariant of E[i], for 0 <= i < n, with a 
+	single inversion.
 	*/
-	fp2 t, t0, t1;
+	fp2 num[n], den[n];
+	for( int i = 0; i < n; i++ ) {
+		fp2_init_none( &(num[i]) );
+		fp2_init_none( &(den[i]) );
+		j_fraction( &(num[i]), &(den[i]), &(E[i]), p );
+	}
+
+	fp2_batch_multinv( n, den, den, p );
+	for( int i = 0; i < n; i++ ) {
+		fp2_mult( &(j[i]), &(num[i]), &(den[i]), p );
+		fp2_clear( &(num[i]) );
+		fp2_clear( &(den[i]) );
+	}
+}
+
+static void A_fraction( fp2 *num, fp2 *den, 
+	fp2 *xP, fp2 *xQ, fp2 *xQminusP, mpz_t p ) {
+	/* Sets num and den such that A = num/den - xP - xQ - x(Q-P).
+	*/
+	fp2 t;
 	fp2_init_none(&t);
-	fp2_init_none(&t0);
-	fp2_init_none(&t1);
 
 	mpz_t un, zero;
 	mpz_inits(un, zero, NULL);
@@ -386,31 +561,95 @@ void get_A( fp2 *A, fp2 *xP, fp2 *xQ, fp2 *xQminusP, mpz_t p ) {
 	fp2 one;
 	fp2_init( &one, un, zero, p );
 
-	fp2_add( &t1, xP, xQ, p );
-	fp2_mult( &t0, xP, xQ, p );
-	fp2_mult( &t, xQminusP, &t1, p );
-	fp2_add( &t, &t, &t0, p );
-
-	fp2_mult( &t0, &t0, xQminusP, p );
-	fp2_sub( &t, &t, &one, p );
-	fp2_add( &t0, &t0, &t0, p );
-	fp2_add( &t1, &t1, xQminusP, p );
-
-	fp2_add( &t0, &t0, &t0, p );
-	fp2_mult( &t, &t, &t, p );
-	fp2_multinv( &t0, &t0, p );
-	fp2_mult( &t, &t, &t0, p );
+	fp2_add( &t, xP, xQ, p );
+	fp2_mult( den, xP, xQ, p );
+	fp2_mult( num, xQminusP, &t, p );
+	fp2_add( num, num, den, p );
 
-	fp2_sub( &t, &t, &t1, p );
+	fp2_mult( den, den, xQminusP, p );
+	fp2_sub( num, num, &one, p );
+	fp2_add( den, den, den, p );
 
-	fp2_set( A, &t );
+	fp2_add( den, den, den, p );
+	fp2_mult( num, num, num, p );
 
 	fp2_clear(&t);
-	fp2_clear(&t0);
-	fp2_clear(&t1);
 	fp2_clear(&one);
 	mpz_clears(un, zero, NULL);
+}
+
+static void A_from_fraction( fp2 *A, fp2 *num, fp2 *inv, 
+	fp2 *xP, fp2 *xQ, fp2 *xQminusP, mpz_t p ) {
+	/* Sets A as num*inv - xP - xQ - x(Q-P).
+	*/
+	fp2 t;
+	fp2_init_none(&t);
+
+	fp2_add( &t, xP, xQ, p );
+	fp2_add( &t, &t, xQminusP, p );
+	fp2_mult( A, num, inv, p );
+	fp2_sub( A, A, &t, p );
+
+	fp2_clear(&t);
+}
 
+void get_A( fp2 *A, fp2 *xP, fp2 *xQ, fp2 *xQminusP, mpz_t p ) {
+	/* Sets A as the first parameter of a curve passing through
+	xP, xQ and x(Q-P).
+	*/
+	fp2 num, den;
+	fp2_init_none(&num);
+	fp2_init_none(&den);
+
+	A_fraction( &num, &den, xP, xQ, xQminusP, p );
+	fp2_multinv( &den, &den, p );
+	A_from_fraction( A, &num, &den, xP, xQ, xQminusP, p );
+
+	fp2_clear(&num);
+	fp2_clear(&den);
+}
+
+void get_A_batch( int n, fp2 A[n], 
+	fp2 *xP[n], fp2 *xQ[n], fp2 *xQminusP[n], mpz_t p ) {
+	/* Sets A[i] as the first parameter of a curve passing through
+	xP[i], xQ[i] and x(Q-P)[i], for 0 <= i < n, with a single inversion.
+	*/
+	fp2 num[n], den[n];
+	for( int i = 0; i < n; i++ ) {
+		fp2_init_none( &(num[i]) );
+		fp2_init_none( &(den[i]) );
+		A_fraction( &(num[i]), &(den[i]), xP[i], xQ[i], xQminusP[i], p );
+	}
+
+	fp2_batch_multinv( n, den, den, p );
+	for( int i = 0; i < n; i++ ) {
+		A_from_fraction( &(A[i]), &(num[i]), &(den[i]), 
+			xP[i], xQ[i], xQminusP[i], p );
+		fp2_clear( &(num[i]) );
+		fp2_clear( &(den[i]) );
+	}
+}
+
+int check_A( fp2 *A, fp2 *xP, fp2 *xQ, fp2 *xQminusP, mpz_t p ) {
+	/* Returns 1 if A is the parameter of the curve passing through
+	xP, xQ and x(Q-P) ( the one given by get_A ), without inversion.
+	*/
+	fp2 num, den, t;
+	fp2_init_none(&num);
+	fp2_init_none(&den);
+	fp2_init_none(&t);
+
+	A_fraction( &num, &den, xP, xQ, xQminusP, p );
+	fp2_add( &t, xP, xQ, p );
+	fp2_add( &t, &t, xQminusP, p );
+	fp2_add( &t, &t, A, p );
+	fp2_mult( &t, &t, &den, p );
+	int same = fp2_are_equal( &t, &num ) && !fp2_is_zero( &den, p );
+
+	fp2_clear(&num);
+	fp2_clear(&den);
+	fp2_clear(&t);
+	return same;
 }
 
 void criss_cross( point *S, point *P, point *Q, mpz_t p ) {
@@ -0,0 +1,211 @@
+/*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*
+*
+* Generation of public parameters for a pair of primes lA, lB :
+* the smallest f such that p = lA^eA * lB^eB * f - 1 is a prime
+* = 3 mod 4, the supersingular curve y^2 = x^3 + x with alpha = i,
+* and torsion bases of both sides ( torsion_basis_x ). The
+* candidates f and the two bases are spread on a pool of
+* threads. The set is checked with param_check and a key
+* exchange, and written on stdout as a parameter file.
+* Build with "make paramgen", run
+* "./Paramgen lA eA lB eB [threads] > file".
+*
+*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <gmp.h>
+#include "Header.h"
+
+#define PRIME_REPS 25 // Miller-Rabin rounds of mpz_probab_prime_p.
+#define BATCH_PER_THREAD 8 // candidates f per thread in a run of the pool.
+#define MAX_BATCHES 100000
+
+/* --------------------------------------------------------
+ 					PRIME SEARCH
+----------------------------------------------------------*/
+
+typedef struct search {
+	mpz_t h; // lA^eA * lB^eB.
+	unsigned long f0; // first candidate of the batch.
+	unsigned long step; // f = f0 + i*step gives p = 3 mod 4.
+	int *prime; // prime[i] = 1 if the candidate i gives a prime.
+} search;
+
+static void search_job( void *arg, int i ) {
+	search *S = arg;
+	mpz_t p;
+	mpz_init( p );
+	mpz_mul_ui( p, S->h, S->f0 + i*S->step );
+	mpz_sub_ui( p, p, 1 );
+	S->prime[i] = ( mpz_probab_prime_p( p, PRIME_REPS ) > 0 );
+	mpz_clear( p );
+}
+
+static unsigned long find_f( mpz_t p, int lA, int eA, int lB, int eB, pool *W ) {
+	/* Sets p = lA^eA * lB^eB * f - 1 for the smallest f giving a prime 
+	= 3 mod 4, and returns f, or 0 if none was found. The candidates are 
+	tested by batches on the threads of W.
+	*/
+	search S;
+	mpz_init( S.h );
+	mpz_ui_pow_ui( S.h, lA, eA );
+	mpz_ui_pow_ui( p, lB, eB );
+	mpz_mul( S.h, S.h, p );
+	// h*f = 0 mod 4, ie f multiple of 4/gcd( h, 4 ).
+	S.step = 4/mpz_gcd_ui( NULL, S.h, 4 );
+	int n = BATCH_PER_THREAD*pool_threads( W );
+	S.prime = malloc( n*sizeof( int ) );
+
+	unsigned long f = 0;
+	S.f0 = S.step;
+	for( int b = 0; b < MAX_BATCHES && f == 0; b++ ) {
+		pool_run( W, n, search_job, &S );
+		for( int i = 0; i < n && f == 0; i++ ) {
+			if( S.prime[i] ) {
+				f = S.f0 + i*S.step;
+			}
+		}
+		S.f0 += n*S.step;
+	}
+	if( f != 0 ) {
+		mpz_mul_ui( p, S.h, f );
+		mpz_sub_ui( p, p, 1 );
+	}
+	free( S.prime );
+	mpz_clear( S.h );
+	return f;
+}
+
+/* --------------------------------------------------------
+ 					TORSION BASES
+----------------------------------------------------------*/
+
+typedef struct bases {
+	mpz_t p;
+	fp2 A;
+	int l[2];
+	int e[2];
+	fp2 x[2][3]; // xP, xQ, xR of each side.
+	int ok[2];
+} bases;
+
+static void basis_job( void *arg, int i ) {
+	bases *B = arg;
+	B->ok[i] = torsion_basis_x( &(B->x[i][0]), &(B->x[i][1]), &(B->x[i][2]),
+		&(B->A), B->l[i], B->e[i], B->p );
+}
+
+/* --------------------------------------------------------
+ 					CHECKS
+----------------------------------------------------------*/
+
+static int test_exchange( parameters *param ) {
+	/* Returns 1 if a key exchange with random secrets gives the same j 
+	invariant on both sides.
+	*/
+	sk SKA, SKB;
+	pk PKA, PKB;
+	sk_generate( &SKA, param->pA, param->eA, NULL );
+	sk_generate( &SKB, param->pB, param->eB, NULL );
+	pk_init_none( &PKA );
+	pk_init_none( &PKB );
+	fp2 jA, jB;
+	fp2_init_none( &jA );
+	fp2_init_none( &jB );
+	if( param->pA == 2 ) {
+		isogen_two( &PKA, &SKA, param );
+		isogen_three( &PKB, &SKB, param );
+		isoex_two( &jA, &SKA, &PKB, param );
+		isoex_three( &jB, &SKB, &PKA, param );
+	}
+	else {
+		isogen_Alice( &PKA, &SKA, param );
+		isogen_Bob( &PKB, &SKB, param );
+		isoex_Alice( &jA, &PKB, &SKA, param );
+		isoex_Bob( &jB, &PKA, &SKB, param );
+	}
+	int ok = fp2_are_equal( &jA, &jB );
+	fp2_clear( &jA );
+	fp2_clear( &jB );
+	pk_clear( &PKA );
+	pk_clear( &PKB );
+	sk_clear( &SKA );
+	sk_clear( &SKB );
+	return ok;
+}
+
+int main( int argc, char const *argv[] ) {
+	if( argc < 5 ) {
+		fprintf( stderr, "Usage : %s lA eA lB eB [threads] > file\n", argv[0] );
+		return 1;
+	}
+	int lA = atoi( argv[1] ), eA = atoi( argv[2] );
+	int lB = atoi( argv[3] ), eB = atoi( argv[4] );
+	int threads = ( argc > 5 ) ? atoi( argv[5] ) : sysconf( _SC_NPROCESSORS_ONLN );
+	if( lA < 2 || lB < 3 || lA == lB || eA < 1 || eB < 1 || ( lA == 2 && lB != 3 ) ) {
+		fprintf( stderr, "lA, lB must be distinct primes, 2 only as lA with lB = 3\n" );
+		return 1;
+	}
+	pool *W = pool_new( threads < 1 ? 1 : threads );
+
+	bases B;
+	mpz_init( B.p );
+	unsigned long f = find_f( B.p, lA, eA, lB, eB, W );
+	if( f == 0 ) {
+		fprintf( stderr, "No f found.\n" );
+		pool_free( W );
+		return 1;
+	}
+	fprintf( stderr, "f = %lu, p of %zu bits\n", f, mpz_sizeinbase( B.p, 2 ) );
+
+	// y^2 = x^3 + x is supersingular for p = 3 mod 4, with (i, 0) of order 2.
+	fp2_init_none( &(B.A) );
+	B.l[0] = lA;
+	B.e[0] = eA;
+	B.l[1] = lB;
+	B.e[1] = eB;
+	for( int i = 0; i < 2; i++ ) {
+		for( int k = 0; k < 3; k++ ) {
+			fp2_init_none( &(B.x[i][k]) );
+		}
+	}
+	pool_run( W, 2, basis_job, &B );
+	if( !B.ok[0] || !B.ok[1] ) {
+		fprintf( stderr, "No torsion basis found.\n" );
+		pool_free( W );
+		return 1;
+	}
+
+	parameters param;
+	init_parameters( &param );
+	set_prime( &param, B.p, lA, lB, eA, eB );
+	mpz_t zero, one;
+	mpz_init_set_ui( zero, 0 );
+	mpz_init_set_ui( one, 1 );
+	set_points( &param, zero, one,
+		B.x[0][0].s0, B.x[0][0].s1, B.x[0][1].s0, B.x[0][1].s1, B.x[0][2].s0, B.x[0][2].s1,
+		B.x[1][0].s0, B.x[1][0].s1, B.x[1][1].s0, B.x[1][1].s1, B.x[1][2].s0, B.x[1][2].s1 );
+	set_pool( &param, W );
+	int checked = param_check( &param );
+	int exchanged = checked && test_exchange( &param );
+	fprintf( stderr, "points : %s, key exchange : %s\n", checked ? "ok" : "WRONG", 
+		exchanged ? "ok" : "WRONG" );
+
+	printf("# Generated by Paramgen %d %d %d %d.\n", lA, eA, lB, eB );
+	param_write( stdout, &param );
+
+	set_pool( &param, NULL );
+	clear_parameters( &param );
+	for( int i = 0; i < 2; i++ ) {
+		for( int k = 0; k < 3; k++ ) {
+			fp2_clear( &(B.x[i][k]) );
+		}
+	}
+	fp2_clear( &(B.A) );
+	mpz_clears( B.p, zero, one, NULL );
+	pool_free( W );
+	return !exchanged;
+}
@@ -27,6 +27,8 @@ void pk_init_none( pk *PK ) {
 	fp2_init_none( &(PK->x1) );
 	fp2_init_none( &(PK->x2) );
 	fp2_init_none( &(PK->x3) );
+	fp2_init_none( &(PK->A) );
+	PK->extended = 0;
 }
 
 void pk_clear( pk *PK ) {
@@ -36,6 +38,7 @@ void pk_clear( pk *PK ) {
 	fp2_clear( &(PK->x1) );
 	fp2_clear( &(PK->x2) );
 	fp2_clear( &(PK->x3) );
+	fp2_clear( &(PK->A) );
 }
 
 void pk_print( pk *PK ) {
@@ -47,9 +50,160 @@ void pk_print( pk *PK ) {
 	fp2_print( &(PK->x2) );
 	printf("x3 :\n");
 	fp2_print( &(PK->x3) );
+	if( PK->extended ) {
+		printf("A :\n");
+		fp2_print( &(PK->A) );
+	}
 	printf("\n\n");
 }
 
+static void curve_A_fraction( fp2 *num, fp2 *den, curve *F, int aminus, mpz_t p ) {
+	/* Sets A/C = num/den, where F is ( A+2C : 4C ), or ( A+2C : A-2C ) 
+	if aminus is set.
+	*/
+	if( aminus ) {
+		// A/C = 2( F.A + F.C ) / ( F.A - F.C ).
+		fp2_add( num, &(F->A), &(F->C), p );
+		fp2_add( num, num, num, p );
+		fp2_sub( den, &(F->A), &(F->C), p );
+	}
+	else {
+		// A/C = ( 4F.A - 2F.C ) / F.C.
+		fp2_add( num, &(F->A), &(F->A), p );
+		fp2_sub( num, num, &(F->C), p );
+		fp2_add( num, num, num, p );
+		fp2_set( den, &(F->C) );
+	}
+}
+
+static void pk_set_A( pk *PK, curve *F, int aminus, parameters *param ) {
+	/* If the public keys are extended, sets PK->A as A/C, where F is 
+	( A+2C : 4C ), or ( A+2C : A-2C ) if aminus is set.
+	*/
+	PK->extended = param->extended_pk;
+	if( !PK->extended ) {
+		return;
+	}
+	fp2 num, den;
+	fp2_init_none( &num );
+	fp2_init_none( &den );
+	curve_A_fraction( &num, &den, F, aminus, param->p );
+	fp2_multinv( &den, &den, param->p );
+	fp2_mult( &(PK->A), &num, &den, param->p );
+	fp2_clear( &num );
+	fp2_clear( &den );
+}
+
+static int pk_get_A( fp2 *A, pk *PK, parameters *param ) {
+	/* Sets A as the coefficient carried by PK and returns 1 if PK is
+	extended and, in validation mode, if A matches the points of PK.
+	Returns 0 otherwise, and the curve has to be recovered.
+	*/
+	if( !PK->extended ) {
+		return 0;
+	}
+	if( param->validate_pk ) {
+		if( !check_A( &(PK->A), &(PK->x1), &(PK->x2), &(PK->x3), param->p ) ) {
+			return 0;
+		}
+		if( param->pA != 2 ) {
+			// The two torsion point (alpha : 1) has to be on the curve,
+			// ie alpha^2 + A alpha + 1 = 0.
+			fp2 t;
+			fp2_init_none( &t );
+			fp2_add( &t, &(PK->beta), &(PK->A), param->p );
+			fp2_mult( &t, &t, &(PK->beta), param->p );
+			mpz_add_ui( t.s0, t.s0, 1 );
+			mpz_mod( t.s0, t.s0, param->p );
+			int on_curve = fp2_is_zero( &t, param->p );
+			fp2_clear( &t );
+			if( !on_curve ) {
+				return 0;
+			}
+		}
+	}
+	fp2_set( A, &(PK->A) );
+	return 1;
+}
+
+static void pk_curve_aplus( curve *E, pk *PK, parameters *param ) {
+	/* Sets E as the curve of PK in the form ( A+2C / 4C : 1 ), from the
+	coefficient of PK if it can be used, and from its two torsion point
+	otherwise.
+	*/
+	fp2 A;
+	fp2_init_none( &A );
+	if( pk_get_A( &A, PK, param ) ) {
+		// ( A+2 )/4, with 1/4 = ( p+1 )/4 since p = 3 mod 4.
+		mpz_t quarter;
+		mpz_init( quarter );
+		mpz_add_ui( quarter, param->p, 1 );
+		mpz_tdiv_q_2exp( quarter, quarter, 2 );
+		mpz_add_ui( A.s0, A.s0, 2 );
+		mpz_mul( A.s0, A.s0, quarter );
+		mpz_mod( A.s0, A.s0, param->p );
+		mpz_mul( A.s1, A.s1, quarter );
+		mpz_mod( A.s1, A.s1, param->p );
+		fp2_set( &(E->A), &A );
+		mpz_set_ui( E->C.s0, 1 );
+		mpz_set_ui( E->C.s1, 0 );
+		mpz_clear( quarter );
+	}
+	else {
+		curve_from_alpha( E, &(PK->beta), param->p );
+		curve_normalize( E, E, param->p );
+	}
+	fp2_clear( &A );
+}
+
+void pk_get_A_batch( int n, fp2 A[n], pk PK[n], mpz_t p ) {
+	/* Sets A[i] as the parameter of the curve given by the abscissas 
+	of PK[i], for 0 <= i < n, with a single inversion.
+	*/
+	fp2 *x1[n], *x2[n], *x3[n];
+	for( int i = 0; i < n; i++ ) {
+		x1[i] = &(PK[i].x1);
+		x2[i] = &(PK[i].x2);
+		x3[i] = &(PK[i].x3);
+	}
+	get_A_batch( n, A, x1, x2, x3, p );
+}
+
+size_t pk_bytes( parameters *param ) {
+	/* Returns the number of bytes of an encoded public key : x1, x2,
+	x3, and beta for the generalized parameters.
+	*/
+	return ( ( param->pA == 2 ) ? 6 : 8 )*fp_bytes( param->p );
+}
+
+void pk_encode( unsigned char *out, pk *PK, parameters *param ) {
+	/* Writes x1, x2, x3, then beta for the generalized parameters, on 
+	pk_bytes( param ) bytes.
+	*/
+	size_t len = 2*fp_bytes( param->p );
+	fp2_encode( out, &(PK->x1), param->p );
+	fp2_encode( out + len, &(PK->x2), param->p );
+	fp2_encode( out + 2*len, &(PK->x3), param->p );
+	if( param->pA != 2 ) {
+		fp2_encode( out + 3*len, &(PK->beta), param->p );
+	}
+}
+
+int pk_decode( pk *PK, const unsigned char *in, parameters *param ) {
+	/* Sets PK from the pk_bytes( param ) bytes of in, and returns 1 if 
+	every coordinate is reduced mod p, 0 otherwise.
+	*/
+	size_t len = 2*fp_bytes( param->p );
+	int ok = fp2_decode( &(PK->x1), in, param->p );
+	ok &= fp2_decode( &(PK->x2), in + len, param->p );
+	ok &= fp2_decode( &(PK->x3), in + 2*len, param->p );
+	if( param->pA != 2 ) {
+		ok &= fp2_decode( &(PK->beta), in + 3*len, param->p );
+	}
+	PK->extended = 0;
+	return ok;
+}
+
 /* --------------------------------------------------------
                     SECRET KEY
 ----------------------------------------------------------*/
@@ -65,6 +219,45 @@ void sk_clear( sk *SK ) {
 	mpz_clear( SK->secret );
 }
 
+size_t sk_bytes( int l, int e ) {
+	/* Returns the number of bytes of an encoded secret mod l^e.
+	*/
+	mpz_t q;
+	mpz_init( q );
+	mpz_ui_pow_ui( q, l, e );
+	mpz_sub_ui( q, q, 1 );
+	size_t n = ( mpz_sizeinbase( q, 2 ) + 7 )/8;
+	mpz_clear( q );
+	return n;
+}
+
+void sk_encode( unsigned char *out, sk *SK, int l, int e ) {
+	/* Writes the secret of SK, mod l^e, on sk_bytes( l, e ) bytes.
+	*/
+	mpz_t q, s;
+	mpz_inits( q, s, NULL );
+	mpz_ui_pow_ui( q, l, e );
+	mpz_mod( s, SK->secret, q );
+	fp_encode( out, s, sk_bytes( l, e ) );
+	mpz_clears( q, s, NULL );
+}
+
+int sk_decode( sk *SK, const unsigned char *in, int l, int e ) {
+	/* Sets SK from the sk_bytes( l, e ) bytes of in, and returns 1 if
+	the secret is smaller than l^e, 0 otherwise.
+	*/
+	fp_decode( SK->secret, in, sk_bytes( l, e ) );
+	if( l == 2 ) {
+		return mpz_sizeinbase( SK->secret, 2 ) <= e;
+	}
+	mpz_t q;
+	mpz_init( q );
+	mpz_ui_pow_ui( q, l, e );
+	int ok = mpz_cmp( SK->secret, q ) < 0;
+	mpz_clear( q );
+	return ok;
+}
+
 /* --------------------------------------------------------
             	PARAMETERS SETTING
 ----------------------------------------------------------*/
@@ -82,6 +275,19 @@ void init_parameters( parameters *param ) {
 	fp2_init_none( &(param->xPB) );
 	fp2_init_none( &(param->xQB) );
 	fp2_init_none( &(param->xRB) );
+
+	param->strategyA = NULL;
+	param->strategyB = NULL;
+	param->W = NULL;
+	param->tableA = NULL;
+	param->tableB = NULL;
+	param->tableA_len = 0;
+	param->tableB_len = 0;
+	param->extended_pk = 0;
+	param->validate_pk = 0;
+	param->constant_time = 0;
+	param->dlogA = NULL;
+	param->dlogB = NULL;
 }
 
 void set_prime( parameters *param, mpz_t p, int pA, int pB, int eA, int eB ) {
@@ -90,6 +296,51 @@ void set_prime( parameters *param, mpz_t p, int pA, int pB, int eA, int eB ) {
 	param->pB = pB ;
 	param->eA = eA;
 	param->eB = eB;
+
+	int regular = ( pA == 2 );
+	free( param->strategyA );
+	free( param->strategyB );
+	param->strategyA = strategy_new( pA, eA, regular );
+	param->strategyB = strategy_new( pB, eB, regular );
+}
+
+static int table_length( int l, int e ) {
+	/* Returns the number of bits of l^e - 1, ie the number of bits
+	of the secrets.
+	*/
+	mpz_t n;
+	mpz_init( n );
+	mpz_ui_pow_ui( n, l, e );
+	mpz_sub_ui( n, n, 1 );
+	int len = ( mpz_sgn( n ) > 0 ) ? mpz_sizeinbase( n, 2 ) : 0;
+	mpz_clear( n );
+	return len;
+}
+
+static void set_tables( parameters *param ) {
+	/* Computes the tables of the doublings of QA and QB on the starting 
+	curve, used by Ladder3pt_table during key generation, and the tables 
+	of pk_compress for both sides.
+	*/
+	ladder_table_free( param->tableA_len, param->tableA );
+	ladder_table_free( param->tableB_len, param->tableB );
+
+	curve E;
+	curve_init_none( &E );
+	curve_from_alpha( &E, &(param->alpha), param->p );
+	// For 2 and 3, alpha = i gives E = ( 1 : 2 ), the starting curve.
+
+	param->tableA_len = table_length( param->pA, param->eA );
+	param->tableB_len = table_length( param->pB, param->eB );
+	param->tableA = ladder_table_new( param->tableA_len, &(param->xQA), &E, param->p );
+	param->tableB = ladder_table_new( param->tableB_len, &(param->xQB), &E, param->p );
+
+	dlog_table_free( param->dlogA );
+	dlog_table_free( param->dlogB );
+	param->dlogA = dlog_table_new( param->pA, param->eA, param->p );
+	param->dlogB = dlog_table_new( param->pB, param->eB, param->p );
+
+	curve_clear( &E );
 }
 
 void set_points( parameters *param, 
@@ -108,6 +359,8 @@ void set_points( parameters *param,
 	fp2_init( &(param->xPB), xPB0, xPB1, param->p );
 	fp2_init( &(param->xQB), xQB0, xQB1, param->p );
 	fp2_init( &(param->xRB), xRB0, xRB1, param->p );
+
+	set_tables( param );
 }
 
 void clear_parameters( parameters *param ) {
@@ -122,6 +375,86 @@ void clear_parameters( parameters *param ) {
 	fp2_clear( &(param->xPB) );
 	fp2_clear( &(param->xQB) );
 	fp2_clear( &(param->xRB) );
+
+	free( param->strategyA );
+	free( param->strategyB );
+	param->strategyA = NULL;
+	param->strategyB = NULL;
+
+	ladder_table_free( param->tableA_len, param->tableA );
+	ladder_table_free( param->tableB_len, param->tableB );
+	param->tableA = NULL;
+	param->tableB = NULL;
+
+	dlog_table_free( param->dlogA );
+	dlog_table_free( param->dlogB );
+	param->dlogA = NULL;
+	param->dlogB = NULL;
+}
+
+void set_extended_pk( parameters *param, int extended, int validate ) {
+	/* Public keys from key generation will carry the coefficient of their
+	curve, used by key exchange, after a check if validate is set.
+	*/
+	param->extended_pk = extended;
+	param->validate_pk = validate;
+}
+
+void set_pool( parameters *param, pool *W ) {
+	/* The images of the points during key generation and exchange
+	will be computed on the threads of W (NULL for none).
+	*/
+	param->W = W;
+}
+
+void set_constant_time( parameters *param, int ct ) {
+	/* The ladders on the secrets will be Ladder3pt_ct if ct is set,
+	the faster Ladder3pt_table and Ladder3pt otherwise.
+	*/
+	param->constant_time = ct;
+}
+
+static void secret_ladder( point *R, mpz_t m, int side, 
+	fp2 *xP, fp2 *xQ, fp2 *xR, curve *E, int aplus, int fixed, parameters *param ) {
+	/* Sets R = Q + [m]P, for m a secret of the side A if side is 0, B
+	otherwise, and E = ( A : C ), or ( A+2C : 4C ) if aplus is set.
+	If fixed is set, P and Q are the basis of the side on the starting
+	curve, and the table of param can be used.
+	With param->constant_time, the ladder is Ladder3pt_ct on the number
+	of bits of l^e - 1, so that it only depends on the parameters.
+	*/
+	int l = side ? param->pB : param->pA;
+	int e = side ? param->eB : param->eA;
+
+	if( param->constant_time ) {
+		int bits = table_length( l, e );
+		if( (int)mpz_sizeinbase( m, 2 ) > bits ) {
+			bits = mpz_sizeinbase( m, 2 ); // not reduced, the size is public.
+		}
+		curve F;
+		curve_init_none( &F );
+		if( aplus ) {
+			curve_set( &F, E );
+		}
+		else {
+			curve_Aplus_C( &F, E, param->p );
+		}
+		Ladder3pt_ct( R, m, bits, xP, xQ, xR, &F, param->p );
+		curve_clear( &F );
+		return;
+	}
+
+	int len = side ? param->tableB_len : param->tableA_len;
+	fp2 *table = side ? param->tableB : param->tableA;
+	if( fixed && Ladder3pt_table( R, m, xP, len, table, xR, param->p ) ) {
+		return;
+	}
+	if( aplus ) {
+		Ladder3pt_without_conversion( R, m, xP, xQ, xR, E, param->p );
+	}
+	else {
+		Ladder3pt( R, m, xP, xQ, xR, E, param->p );
+	}
 }
 
 /* --------------------------------------------------------
@@ -143,12 +476,13 @@ void isogen_two( pk *PK2, sk *SK2, parameters *param ) {
 
 	point S;
 	point_init_none(&S);
-	Ladder3pt( &S, 
-	 	(SK2->secret), &(param->xPA), &(param->xQA), &(param->xRA), &E, (param->p) );
+	secret_ladder( &S, (SK2->secret), 0, 
+		&(param->xPA), &(param->xQA), &(param->xRA), &E, 0, 1, param );
 	// Now S = [secret]P2 + Q2.
 
-	two_e_iso( &F, &P1, &P2, &P3, 
-		&F, &S, &P1, &P2, &P3, param->eA, param->p );
+	point *P[3] = { &P1, &P2, &P3 };
+	two_e_iso_strategy( &F, 3, P, 
+		&F, &S, P, param->eA, param->strategyA, param->p, param->W );
 	// Now F = Ea, the image of E by the 2^e2 isogeny with kernel <S>.
 
 	point_normalize( &P1, &P1, param->p );
@@ -159,6 +493,7 @@ void isogen_two( pk *PK2, sk *SK2, parameters *param ) {
 	fp2_set( &(PK2->x2), &(P2.X) );
 	fp2_set( &(PK2->x3), &(P3.X) );
 	// F can be described with abscisses x1, x2, and x3.
+	pk_set_A( PK2, &F, 0, param );
 
 	point_clear(&S);
 	point_clear(&P1);
@@ -183,11 +518,12 @@ void isogen_three( pk *PK3, sk *SK3, parameters *param ) {
 
 	point S;
 	point_init_none(&S);
-	Ladder3pt( &S, 
-		(SK3->secret), &(param->xPB), &(param->xQB), &(param->xRB), &E, (param->p) );
+	secret_ladder( &S, (SK3->secret), 1, 
+		&(param->xPB), &(param->xQB), &(param->xRB), &E, 0, 1, param );
 	
-	three_e_iso( &F, &P1, &P2, &P3, 
-		&F, &S, &P1, &P2, &P3, param->eB, param->p );
+	point *P[3] = { &P1, &P2, &P3 };
+	three_e_iso_strategy( &F, 3, P, 
+		&F, &S, P, param->eB, param->strategyB, param->p, param->W );
 
 	point_normalize( &P1, &P1, param->p );
 	point_normalize( &P2, &P2, param->p );
@@ -196,6 +532,7 @@ void isogen_three( pk *PK3, sk *SK3, parameters *param ) {
 	fp2_set( &(PK3->x1), &(P1.X) );
 	fp2_set( &(PK3->x2), &(P2.X) );
 	fp2_set( &(PK3->x3), &(P3.X) );
+	pk_set_A( PK3, &F, 1, param );
 
 	point_clear(&S);
 	point_clear(&P1);
@@ -209,31 +546,31 @@ void isogen_three( pk *PK3, sk *SK3, parameters *param ) {
                	KEY EXCHANGE REGULAR
 ----------------------------------------------------------*/
 
-void isoex_two( fp2 *j, sk *SK2, pk *PK3, parameters *param ) {
+static void isoex_two_curve( curve *G, sk *SK2, pk *PK3, parameters *param ) {
 	/* Key exchange for the "two-isogeny side".
-	Sets j as the j invariant of the common curve.
+	Sets G as the common curve.
 	*/
 	curve E;
 	curve_init_none(&E);
 	fp2 A;
 	fp2_init_none(&A);
 
-	get_A( &A, &(PK3->x1), &(PK3->x2), &(PK3->x3), param->p );
+	if( !pk_get_A( &A, PK3, param ) ) {
+		get_A( &A, &(PK3->x1), &(PK3->x2), &(PK3->x3), param->p );
+	}
 	curve_init_normalize( &E, &A, param->p );
 
 	point S;
 	point_init_none(&S);
-	Ladder3pt( &S, 
-		SK2->secret, &(PK3->x1), &(PK3->x2), &(PK3->x3), &E, param->p );
+	secret_ladder( &S, SK2->secret, 0, 
+		&(PK3->x1), &(PK3->x2), &(PK3->x3), &E, 0, 0, param );
 
 	// (Aplus, C) = (A+2, 4)
 	curve F;
 	curve_init_none(&F);
 	curve_Aplus_C( &F, &E, param->p );
 
-	point T;
-	point_init_none(&T);
-	two_e_iso( &F, &T, &T, &T, &F, &S, &T, &T, &T, param->eA, param->p );
+	two_e_iso_without_points( &F, &F, &S, param->eA, param->strategyA, param->p, param->W );
 
 	// (A, C) = (4Aplus - 2C, C)
 	fp2_set( &(E.C), &(F.C) );
@@ -244,41 +581,62 @@ void isoex_two( fp2 *j, sk *SK2, pk *PK3, parameters *param ) {
 	fp2_add( &(E.A), &(E.A), &(E.A), param->p );
 	fp2_sub( &(E.A), &(E.A), &tmp, param->p );
 
-	jInvariant( j, &E, param->p );
+	curve_set( G, &E );
 
 	fp2_clear(&tmp);
-	point_clear(&T);
 	curve_clear(&F);
 	point_clear(&S);
 	fp2_clear(&A);
 	curve_clear(&E);
 }
 
-void isoex_three( fp2 *j, sk *SK3, pk *PK2, parameters *param ) {
-	/* Key exchange for the "three-isogeny side".
+void isoex_two( fp2 *j, sk *SK2, pk *PK3, parameters *param ) {
+	/* Key exchange for the "two-isogeny side".
 	Sets j as the j invariant of the common curve.
 	*/
+	curve G;
+	curve_init_none( &G );
+	isoex_two_curve( &G, SK2, PK3, param );
+	jInvariant( j, &G, param->p );
+	curve_clear( &G );
+}
+
+void isoex_two_projective( fp2 *num, fp2 *den, sk *SK2, pk *PK3, parameters *param ) {
+	/* Same as isoex_two, with the j invariant given as num/den, without
+	inversion. Compare it with j_are_equal.
+	*/
+	curve G;
+	curve_init_none( &G );
+	isoex_two_curve( &G, SK2, PK3, param );
+	jInvariant_projective( num, den, &G, param->p );
+	curve_clear( &G );
+}
+
+static void isoex_three_curve( curve *G, sk *SK3, pk *PK2, parameters *param ) {
+	/* Key exchange for the "three-isogeny side".
+	Sets G as the common curve.
+	*/
 	curve E;
 	curve_init_none(&E);
 	fp2 A;
 	fp2_init_none(&A);
 
-	get_A( &A, &(PK2->x1), &(PK2->x2), &(PK2->x3), param->p );
+	if( !pk_get_A( &A, PK2, param ) ) {
+		get_A( &A, &(PK2->x1), &(PK2->x2), &(PK2->x3), param->p );
+	}
 	curve_init_normalize( &E, &A, param->p );
 
 	point S;
 	point_init_none(&S);
-	Ladder3pt( &S, 
-		SK3->secret, &(PK2->x1), &(PK2->x2), &(PK2->x3), &E, param->p );
+	secret_ladder( &S, SK3->secret, 1, 
+		&(PK2->x1), &(PK2->x2), &(PK2->x3), &E, 0, 0, param );
 
 	// (Aplus, C) = (A+2, A-2)
 	curve F;
 	curve_init_none(&F);
 	curve_Aplus_Aminus( &F, &E, param->p );
 
-	point T;
-	point_init_none(&T);
-	three_e_iso( &F, &T, &T, &T, &F, &S, &T, &T, &T, param->eB, param->p );
+	three_e_iso_without_points( &F, &F, &S, param->eB, param->strategyB, param->p, param->W );
 
 	// (E.A, E.C) = (2*( F.A + F.C ), ( F.A - F.C ) )
 	fp2 tmp;
@@ -287,16 +645,37 @@ void isoex_three( fp2 *j, sk *SK3, pk *PK2, parameters *param ) {
 	fp2_add( &(E.A), &(F.A), &(F.C), param->p );
 	fp2_add( &(E.A), &(E.A), &(E.A), param->p );
 
-	jInvariant( j, &E, param->p );
+	curve_set( G, &E );
 
 	fp2_clear(&tmp);
-	point_clear(&T);
 	curve_clear(&F);
 	point_clear(&S);
 	fp2_clear(&A);
 	curve_clear(&E);
 }
 
+void isoex_three( fp2 *j, sk *SK3, pk *PK2, parameters *param ) {
+	/* Key exchange for the "three-isogeny side".
+	Sets j as the j invariant of the common curve.
+	*/
+	curve G;
+	curve_init_none( &G );
+	isoex_three_curve( &G, SK3, PK2, param );
+	jInvariant( j, &G, param->p );
+	curve_clear( &G );
+}
+
+void isoex_three_projective( fp2 *num, fp2 *den, sk *SK3, pk *PK2, parameters *param ) {
+	/* Same as isoex_three, with the j invariant given as num/den, without
+	inversion. Compare it with j_are_equal.
+	*/
+	curve G;
+	curve_init_none( &G );
+	isoex_three_curve( &G, SK3, PK2, param );
+	jInvariant_projective( num, den, &G, param->p );
+	curve_clear( &G );
+}
+
 /* --------------------------------------------------------
                	KEY GENERATION GENERAL
 ----------------------------------------------------------*/
@@ -322,37 +701,23 @@ void isogen_Alice( pk *PKA, sk *SKA, parameters *param ) {
 	point R;
 	point_init_none( &R );
 	// Note that E is already in the form aPlus = (A+2C / 4C : 1).
-	Ladder3pt_without_conversion( &R, 
-		(SKA->secret), &(param->xPA), &(param->xQA), &(param->xRA), &E, (param->p) );
+	secret_ladder( &R, (SKA->secret), 0, 
+		&(param->xPA), &(param->xQA), &(param->xRA), &E, 1, 1, param );
 	// Now R = [secret]PA + QA
 
 	curve F;
 	curve_init_none( &F );
-	point S;
-	point_init_none( &S );
-	mpz_t q;
-	mpz_init(q);
-	
-	for( int i = ( (param->eA) - 1); i>= 0; i-- ) {
-		curve_from_Alpha( &F, &Beta, param->p ); 
-	 	// WATCH OUT ! F will be in the form ( A+2C, 4C ) !	
-	 	mpz_ui_pow_ui( q, (param->pA), i );
-
-	 	Ladder( &S, &R, &F, q, param->p );
-
-	 	simultaneous_odd_isogeny( &R, &Beta, 
-	 		&P1, &P2, &P3, 
-	 		&S, &F, &P1, &P2, &P3, 
-	 		param->p, ( (param->pA)-1)/2 ); 
-	}
+	point *P[3] = { &P1, &P2, &P3 };
+	odd_e_iso_strategy( &F, &Beta, 3, P, 
+		&E, &R, P, param->pA, param->eA, param->strategyA, param->p, param->W );
+	// WATCH OUT ! F is in the form ( A+2C, 4C ) !
 
 	point_normalize_X( &(PKA->beta), &Beta, param->p );
 	point_normalize_X( &(PKA->x1), &P1, param->p );
 	point_normalize_X( &(PKA->x2), &P2, param->p );
 	point_normalize_X( &(PKA->x3), &P3, param->p );
+	pk_set_A( PKA, &F, 0, param );
 
-	mpz_clear(q);
-	point_clear(&S);
 	curve_clear(&F);
 	point_clear(&R);
 	curve_clear(&E);
@@ -383,38 +748,24 @@ void isogen_Bob( pk *PKB, sk *SKB, parameters *param ) {
 	
 	point R;
 	point_init_none( &R );
-	Ladder3pt_without_conversion( &R, 
-	 	(SKB->secret), &(param->xPB), &(param->xQB), &(param->xRB), &E, (param->p) );
+	secret_ladder( &R, (SKB->secret), 1, 
+		&(param->xPB), &(param->xQB), &(param->xRB), &E, 1, 1, param );
 	// Now R = PB + [secret]QB.
 
 	curve F;
 	curve_init_none( &F );
-	point S;
-	point_init_none( &S );
-	mpz_t q;
-	mpz_init(q);
-	
-	for( int i = ( (param->eB) - 1 ); i>= 0; i-- ) {
-		curve_from_Alpha( &F, &Beta, param->p ); 
-		// WATCH OUT ! F will be in the form ( A+2C, 4C ) !
-
-		mpz_ui_pow_ui( q, (param->pB), i );
-
-		Ladder( &S, &R, &F, q, param->p );
-
-		simultaneous_odd_isogeny( &R, &Beta, 
-			&P1, &P2, &P3, 
-			&S, &F, &P1, &P2, &P3, 
-			param->p, ( (param->pB)-1)/2 ); 
-	}
+	point *P[3] = { &P1, &P2, &P3 };
+	odd_e_iso_strategy( &F, &Beta, 3, P, 
+		&E, &R, P, param->pB, param->eB, param->strategyB, param->p, param->W );
+	// WATCH OUT ! F is in the form ( A+2C, 4C ) !
 	point_normalize_X( &(PKB->beta), &Beta, param->p );
 	point_normalize_X( &(PKB->x1), &P1, param->p );
 	point_normalize_X( &(PKB->x2), &P2, param->p );
 	point_normalize_X( &(PKB->x3), &P3, param->p );
+	pk_set_A( PKB, &F, 0, param );
 
-	mpz_clear(q);
-	point_clear(&S);
 	curve_clear(&F);
+	curve_clear(&E);
 	point_clear(&R);
 	point_clear(&Beta);
 	point_clear(&P1);
@@ -427,8 +778,17 @@ void isogen_Bob( pk *PKB, sk *SKB, parameters *param ) {
                	KEY EXCHANGE GENERAL
 ----------------------------------------------------------*/
 
-void isoex_Alice( fp2 *jA, pk *PKB, sk *SKA, parameters *param ) {
-	/* Key exchange for any odd isogeny.
+static point *exchange_beta( point *Beta, int l ) {
+	/* Returns the two torsion point to push through the exchange chain of 
+	degree l^e, or NULL to compute each codomain from its kernel with
+	odd_iso_curve, which is faster from l = 5 ( see bench_codomain ).
+	*/
+	return ( l < 5 ) ? Beta : NULL;
+}
+
+static void isoex_Alice_curve( curve *G, pk *PKB, sk *SKA, parameters *param ) {
+	/* Key exchange for any odd isogeny. Sets G as the common curve,
+	in the form ( A+2C : 4C ).
 
 	Variable written with a capital letter are points. Variable written
 	with a small letter are elements from Fp2.
@@ -439,48 +799,53 @@ void isoex_Alice( fp2 *jA, pk *PKB, sk *SKA, parameters *param ) {
 
 	curve EB;
 	curve_init_none( &EB );
-	curve_from_Alpha( &EB, &Beta, param->p );
-	curve_normalize( &EB, &EB, param->p );
+	pk_curve_aplus( &EB, PKB, param );
 
 	point R;
 	point_init_none( &R );
-	Ladder3pt_without_conversion( &R, 
-	 	(SKA->secret), &(PKB->x1), &(PKB->x2), &(PKB->x3), &EB, (param->p) );
+	secret_ladder( &R, (SKA->secret), 0, 
+		&(PKB->x1), &(PKB->x2), &(PKB->x3), &EB, 1, 0, param );
 	// Now R = phiB(PA) + [secret]phiB(QA).
 
 	curve F;
 	curve_init_none( &F );
-	point S;
-	point_init_none( &S );
-	mpz_t q;
-	mpz_init(q);
-	
-	for( int i = ( (param->eA) - 1 ); i>= 0; i-- ){
-		mpz_ui_pow_ui( q, (param->pA), i );
-		curve_from_Alpha( &F, &Beta, param->p ); 
-		Ladder( &S, &R, &F, q, param->p );
-
-		simultaneous_odd_isogeny_without_points( &R, &Beta, 
-			&S, &F, 
-			param->p, ( (param->pA)-1)/2 ); 
-	}
-	
-	curve EAB;
-	curve_init_none( &EAB );
-	curve_from_Alpha( &EAB, &Beta, param->p );
-	jInvariant( jA, &EAB, param->p );
+	odd_e_iso_strategy( &F, exchange_beta( &Beta, param->pA ), 0, NULL, 
+		&EB, &R, NULL, param->pA, param->eA, param->strategyA, param->p, param->W );
+
+	curve_set( G, &F );
 
-	curve_clear(&EAB);
-	mpz_clear(q);
-	point_clear(&S);
 	curve_clear(&F);
+	curve_clear(&EB);
 	point_clear(&R);
 	point_clear(&Beta);
 
 }
 
-void isoex_Bob( fp2 *jB, pk *PKA, sk *SKB, parameters *param ) {
+void isoex_Alice( fp2 *jA, pk *PKB, sk *SKA, parameters *param ) {
 	/* Key exchange for any odd isogeny.
+	Sets jA as the j invariant of the common curve.
+	*/
+	curve G;
+	curve_init_none( &G );
+	isoex_Alice_curve( &G, PKB, SKA, param );
+	jInvariant( jA, &G, param->p );
+	curve_clear( &G );
+}
+
+void isoex_Alice_projective( fp2 *num, fp2 *den, pk *PKB, sk *SKA, parameters *param ) {
+	/* Same as isoex_Alice, with the j invariant given as num/den, without
+	inversion. Compare it with j_are_equal.
+	*/
+	curve G;
+	curve_init_none( &G );
+	isoex_Alice_curve( &G, PKB, SKA, param );
+	jInvariant_projective( num, den, &G, param->p );
+	curve_clear( &G );
+}
+
+static void isoex_Bob_curve( curve *G, pk *PKA, sk *SKB, parameters *param ) {
+	/* Key exchange for any odd isogeny. Sets G as the common curve,
+	in the form ( A+2C : 4C ).
 
 	Variable written with a capital letter are points. Variable written
 	with a small letter are elements from Fp2.
@@ -491,48 +856,202 @@ void isoex_Bob( fp2 *jB, pk *PKA, sk *SKB, parameters *param ) {
 
 	curve EA;
 	curve_init_none( &EA );
-	curve_from_Alpha( &EA, &Beta, param->p );
-	curve_normalize( &EA, &EA, param->p );
+	pk_curve_aplus( &EA, PKA, param );
 
 	point R;
 	point_init_none( &R );
-	Ladder3pt_without_conversion( &R, 
-	 	(SKB->secret), &(PKA->x1), &(PKA->x2), &(PKA->x3), &EA, (param->p) );
+	secret_ladder( &R, (SKB->secret), 1, 
+		&(PKA->x1), &(PKA->x2), &(PKA->x3), &EA, 1, 0, param );
 	// Now R = phiA(PB) + [secret]phiA(QB).
 
 	curve F;
 	curve_init_none( &F );
-	point S;
-	point_init_none( &S );
-	mpz_t q;
-	mpz_init(q);
-	
-	for( int i = ( (param->eB) - 1 ); i>= 0; i-- ){
-		mpz_ui_pow_ui( q, (param->pB), i );
-		curve_from_Alpha( &F, &Beta, param->p ); 
-		Ladder( &S, &R, &F, q, param->p );
-
-		simultaneous_odd_isogeny_without_points( &R, &Beta, 
-			&S, &F,
-			param->p, ( (param->pB)-1)/2 ); 
-	}
+	odd_e_iso_strategy( &F, exchange_beta( &Beta, param->pB ), 0, NULL, 
+		&EA, &R, NULL, param->pB, param->eB, param->strategyB, param->p, param->W );
 
-	curve EAB;
-	curve_init_none( &EAB );
-	curve_from_Alpha( &EAB, &Beta, param->p );
-	jInvariant( jB, &EAB, param->p );
+	curve_set( G, &F );
 
-	curve_clear(&EAB);
-	mpz_clear(q);
-	point_clear(&S);
 	curve_clear(&F);
+	curve_clear(&EA);
 	point_clear(&R);
 	point_clear(&Beta);
 
 }
 
+void isoex_Bob( fp2 *jB, pk *PKA, sk *SKB, parameters *param ) {
+	/* Key exchange for any odd isogeny.
+	Sets jB as the j invariant of the common curve.
+	*/
+	curve G;
+	curve_init_none( &G );
+	isoex_Bob_curve( &G, PKA, SKB, param );
+	jInvariant( jB, &G, param->p );
+	curve_clear( &G );
+}
 
+void isoex_Bob_projective( fp2 *num, fp2 *den, pk *PKA, sk *SKB, parameters *param ) {
+	/* Same as isoex_Bob, with the j invariant given as num/den, without
+	inversion. Compare it with j_are_equal.
+	*/
+	curve G;
+	curve_init_none( &G );
+	isoex_Bob_curve( &G, PKA, SKB, param );
+	jInvariant_projective( num, den, &G, param->p );
+	curve_clear( &G );
+}
 
+/* --------------------------------------------------------
+               	KEY GENERATION BATCH
+----------------------------------------------------------*/
+
+typedef struct isogen_batch_data {
+	int side; // 0 for A, 1 for B.
+	int general; // generalized parameters : Beta is pushed through too.
+	sk *SK;
+	parameters *param;
+	curve E; // starting curve, for the ladder.
+	curve F; // starting curve of the isogeny chain.
+	point P0[4]; // basis of the other side and Beta, normalized once.
+	point (*P)[4]; // images of P0, for each key.
+	curve *G; // image curve, for each key.
+} isogen_batch_data;
+
+static void isogen_batch_job( void *arg, int i ) {
+	/* Pushes the points of B through the isogeny of the secret key i, 
+	as in isogen_two, isogen_three, isogen_Alice and isogen_Bob, but 
+	leaves them projective. The images are not computed on param->W, 
+	the keys being spread on the threads instead.
+	*/
+	isogen_batch_data *B = arg;
+	parameters *param = B->param;
+	fp2 *xP = B->side ? &(param->xPB) : &(param->xPA);
+	fp2 *xQ = B->side ? &(param->xQB) : &(param->xQA);
+	fp2 *xR = B->side ? &(param->xRB) : &(param->xRA);
+
+	for( int k = 0; k < 3 + B->general; k++ ) {
+		point_set( &(B->P[i][k]), &(B->P0[k]) );
+	}
+	curve_set( &(B->G[i]), &(B->F) );
+
+	point S;
+	point_init_none( &S );
+	secret_ladder( &S, (B->SK[i].secret), B->side, 
+		xP, xQ, xR, &(B->E), B->general, 1, param );
+
+	point *P[3] = { &(B->P[i][0]), &(B->P[i][1]), &(B->P[i][2]) };
+	if( B->general ) {
+		int l = B->side ? param->pB : param->pA;
+		int e = B->side ? param->eB : param->eA;
+		int *strategy = B->side ? param->strategyB : param->strategyA;
+		odd_e_iso_strategy( &(B->G[i]), &(B->P[i][3]), 3, P, 
+			&(B->G[i]), &S, P, l, e, strategy, param->p, NULL );
+	}
+	else if( B->side ) {
+		three_e_iso_strategy( &(B->G[i]), 3, P, 
+			&(B->G[i]), &S, P, param->eB, param->strategyB, param->p, NULL );
+	}
+	else {
+		two_e_iso_strategy( &(B->G[i]), 3, P, 
+			&(B->G[i]), &S, P, param->eA, param->strategyA, param->p, NULL );
+	}
+	point_clear( &S );
+}
 
+void isogen_batch( int n, pk PK[n], sk SK[n], int side, parameters *param, pool *W ) {
+	/* Sets PK[i] as the public key of SK[i] for 0 <= i < n, on the side
+	A if side is 0, B otherwise. The starting points and curves are set 
+	once for the batch, the keys are spread on the threads of W, and all
+	the normalizations share a single inversion.
+	*/
+	if( n <= 0 ) {
+		return;
+	}
+	isogen_batch_data B;
+	B.side = side;
+	B.general = ( param->pA != 2 );
+	B.SK = SK;
+	B.param = param;
+	int m = 3 + B.general; // points per key.
+	int ext = param->extended_pk;
+
+	curve_init_ui( &(B.E), 0, 0, 1, 0, param->p ); // (A : C) = (0 : 1)
+	if( B.general ) {
+		curve_from_alpha( &(B.E), &(param->alpha), param->p );
+		curve_normalize( &(B.E), &(B.E), param->p );
+		curve_init_fp( &(B.F), &(B.E.A), &(B.E.C) );
+		point_init_normalize( &(B.P0[3]), &(param->alpha), param->p );
+	}
+	else if( side ) {
+		curve_init_ui( &(B.F), 2, 0, -2, 0, param->p ); // (A+2C : A-2C)
+	}
+	else {
+		curve_init_ui( &(B.F), 1, 0, 2, 0, param->p ); // (A+2C : 4C)
+	}
+	point_init_normalize( &(B.P0[0]), side ? &(param->xPA) : &(param->xPB), param->p );
+	point_init_normalize( &(B.P0[1]), side ? &(param->xQA) : &(param->xQB), param->p );
+	point_init_normalize( &(B.P0[2]), side ? &(param->xRA) : &(param->xRB), param->p );
+
+	B.P = malloc( n*sizeof( point[4] ) );
+	B.G = malloc( n*sizeof( curve ) );
+	for( int i = 0; i < n; i++ ) {
+		for( int k = 0; k < m; k++ ) {
+			point_init_none( &(B.P[i][k]) );
+		}
+		curve_init_none( &(B.G[i]) );
+	}
 
+	pool_run( W, n, isogen_batch_job, &B );
+
+	// z holds the Z of the m points of each key, then the denominator
+	// of A/C if the keys are extended, and all of them are inverted at once.
+	int c = m + ext;
+	fp2 *z = malloc( n*c*sizeof( fp2 ) );
+	fp2 *num = malloc( n*sizeof( fp2 ) );
+	for( int i = 0; i < n; i++ ) {
+		for( int k = 0; k < c; k++ ) {
+			fp2_init_none( &(z[i*c + k]) );
+		}
+		fp2_init_none( &(num[i]) );
+		for( int k = 0; k < m; k++ ) {
+			fp2_set( &(z[i*c + k]), &(B.P[i][k].Z) );
+		}
+		if( ext ) {
+			curve_A_fraction( &(num[i]), &(z[i*c + m]), &(B.G[i]), 
+				!B.general && side, param->p );
+		}
+	}
+	fp2_batch_multinv( n*c, z, z, param->p );
+
+	for( int i = 0; i < n; i++ ) {
+		fp2_mult( &(PK[i].x1), &(B.P[i][0].X), &(z[i*c]), param->p );
+		fp2_mult( &(PK[i].x2), &(B.P[i][1].X), &(z[i*c + 1]), param->p );
+		fp2_mult( &(PK[i].x3), &(B.P[i][2].X), &(z[i*c + 2]), param->p );
+		if( B.general ) {
+			fp2_mult( &(PK[i].beta), &(B.P[i][3].X), &(z[i*c + 3]), param->p );
+		}
+		PK[i].extended = ext;
+		if( ext ) {
+			fp2_mult( &(PK[i].A), &(num[i]), &(z[i*c + m]), param->p );
+		}
+	}
 
+	for( int i = 0; i < n; i++ ) {
+		for( int k = 0; k < c; k++ ) {
+			fp2_clear( &(z[i*c + k]) );
+		}
+		fp2_clear( &(num[i]) );
+		for( int k = 0; k < m; k++ ) {
+			point_clear( &(B.P[i][k]) );
+		}
+		curve_clear( &(B.G[i]) );
+	}
+	for( int k = 0; k < m; k++ ) {
+		point_clear( &(B.P0[k]) );
+	}
+	curve_clear( &(B.E) );
+	curve_clear( &(B.F) );
+	free( z );
+	free( num );
+	free( B.P );
+	free( B.G );
+}
@@ -0,0 +1,441 @@
+/*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*
+*
+* Contains methods to handle polynomials over Fp², stored
+* as arrays of coefficients (lowest degree first) :
+* multiplication, reduction modulo a monic polynomial,
+* product and remainder trees, together with their cost
+* in number of fp2 multiplications.
+* Used by the square-root Velu formulas.
+*
+*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include <gmp.h>
+#include "Header.h"
+
+// Below this size, schoolbook multiplication is used.
+#define KARATSUBA_THRESHOLD 4
+
+
+/* ---------------------------------------------------------
+                       BASIC PART
+-----------------------------------------------------------*/
+
+fp2 *poly_new( int n ) {
+	/* Allocates and initializes a polynomial with n coefficients,
+	all set to 0.
+	*/
+	fp2 *f = malloc( ( n > 0 ? n : 1 ) * sizeof(fp2) );
+	for( int i = 0; i < n; i++ ) {
+		fp2_init_none( &(f[i]) );
+	}
+	return f;
+}
+
+void poly_free( int n, fp2 *f ) {
+	/* Clears the n coefficients of f, and frees f.
+	*/
+	for( int i = 0; i < n; i++ ) {
+		fp2_clear( &(f[i]) );
+	}
+	free( f );
+}
+
+void poly_mult( fp2 *h, fp2 *f, int n, fp2 *g, int m, mpz_t p ) {
+	/* Sets h as f*g, where f has n coefficients and g has m coefficients.
+	h has n+m-1 coefficients, and may not overlap f or g.
+	Uses Karatsuba above KARATSUBA_THRESHOLD.
+	*/
+	if( n < m ) {
+		poly_mult( h, g, m, f, n, p );
+		return;
+	}
+	if( m <= 0 ) {
+		return;
+	}
+
+	if( m < KARATSUBA_THRESHOLD ) {
+		fp2 tmp;
+		fp2_init_none( &tmp );
+		for( int i = 0; i < n+m-1; i++ ) {
+			mpz_set_ui( h[i].s0, 0 );
+			mpz_set_ui( h[i].s1, 0 );
+		}
+		for( int i = 0; i < n; i++ ) {
+			for( int j = 0; j < m; j++ ) {
+				fp2_mult( &tmp, &(f[i]), &(g[j]), p );
+				fp2_add( &(h[i+j]), &(h[i+j]), &tmp, p );
+			}
+		}
+		fp2_clear( &tmp );
+		return;
+	}
+
+	int k = ( n+1 )/2; // f = f0 + x^k f1.
+
+	if( m <= k ) {
+		// Unbalanced case : h = f0*g + x^k f1*g.
+		fp2 *t0 = poly_new( k+m-1 );
+		fp2 *t1 = poly_new( n-k+m-1 );
+		poly_mult( t0, f, k, g, m, p );
+		poly_mult( t1, f+k, n-k, g, m, p );
+		for( int i = 0; i < n+m-1; i++ ) {
+			mpz_set_ui( h[i].s0, 0 );
+			mpz_set_ui( h[i].s1, 0 );
+		}
+		for( int i = 0; i < k+m-1; i++ ) {
+			fp2_set( &(h[i]), &(t0[i]) );
+		}
+		for( int i = 0; i < n-k+m-1; i++ ) {
+			fp2_add( &(h[i+k]), &(h[i+k]), &(t1[i]), p );
+		}
+		poly_free( k+m-1, t0 );
+		poly_free( n-k+m-1, t1 );
+		return;
+	}
+
+	// Karatsuba : h = z0 + x^k ( (f0+f1)(g0+g1) - z0 - z2 ) + x^2k z2.
+	fp2 *z0 = poly_new( 2*k-1 );
+	fp2 *z1 = poly_new( 2*k-1 );
+	fp2 *z2 = poly_new( n+m-2*k-1 );
+	fp2 *sf = poly_new( k );
+	fp2 *sg = poly_new( k );
+
+	for( int i = 0; i < k; i++ ) {
+		fp2_set( &(sf[i]), &(f[i]) );
+		if( i < n-k ) {
+			fp2_add( &(sf[i]), &(sf[i]), &(f[k+i]), p );
+		}
+		fp2_set( &(sg[i]), &(g[i]) );
+		if( i < m-k ) {
+			fp2_add( &(sg[i]), &(sg[i]), &(g[k+i]), p );
+		}
+	}
+	poly_mult( z0, f, k, g, k, p );
+	poly_mult( z2, f+k, n-k, g+k, m-k, p );
+	poly_mult( z1, sf, k, sg, k, p );
+
+	for( int i = 0; i < 2*k-1; i++ ) {
+		fp2_sub( &(z1[i]), &(z1[i]), &(z0[i]), p );
+		if( i < n+m-2*k-1 ) {
+			fp2_sub( &(z1[i]), &(z1[i]), &(z2[i]), p );
+		}
+	}
+
+	for( int i = 0; i < n+m-1; i++ ) {
+		mpz_set_ui( h[i].s0, 0 );
+		mpz_set_ui( h[i].s1, 0 );
+	}
+	for( int i = 0; i < 2*k-1; i++ ) {
+		fp2_set( &(h[i]), &(z0[i]) );
+	}
+	for( int i = 0; i < n+m-2*k-1; i++ ) {
+		fp2_add( &(h[2*k+i]), &(h[2*k+i]), &(z2[i]), p );
+	}
+	for( int i = 0; i < 2*k-1; i++ ) {
+		fp2_add( &(h[k+i]), &(h[k+i]), &(z1[i]), p );
+	}
+
+	poly_free( 2*k-1, z0 );
+	poly_free( 2*k-1, z1 );
+	poly_free( n+m-2*k-1, z2 );
+	poly_free( k, sf );
+	poly_free( k, sg );
+}
+
+static void poly_reciprocal( fp2 *inv, fp2 *a, int n, int k, mpz_t p ) {
+	/* Sets inv (k coefficients) as 1/a mod x^k, using Newton iteration.
+	a has n coefficients.
+
+	WATCH OUT ! a[0] has to be 1.
+	*/
+	for( int i = 0; i < k; i++ ) {
+		mpz_set_ui( inv[i].s0, 0 );
+		mpz_set_ui( inv[i].s1, 0 );
+	}
+	mpz_set_ui( inv[0].s0, 1 );
+
+	for( int t = 1; t < k; ) {
+		int t2 = ( 2*t < k ) ? 2*t : k;
+		int na = ( n < t2 ) ? n : t2;
+
+		// e = a*inv = 1 mod x^t, we only need its coefficients t..t2-1.
+		fp2 *e = poly_new( na+t-1 );
+		poly_mult( e, a, na, inv, t, p );
+		fp2 *d = poly_new( t2-t );
+		for( int i = t; i < t2 && i < na+t-1; i++ ) {
+			fp2_set( &(d[i-t]), &(e[i]) );
+		}
+
+		// inv = inv - inv*(e-1) mod x^t2.
+		fp2 *c = poly_new( 2*(t2-t)-1 );
+		poly_mult( c, inv, t2-t, d, t2-t, p );
+		for( int i = 0; i < t2-t; i++ ) {
+			fp2_addinv( &(inv[t+i]), &(c[i]), p );
+		}
+
+		poly_free( na+t-1, e );
+		poly_free( t2-t, d );
+		poly_free( 2*(t2-t)-1, c );
+		t = t2;
+	}
+}
+
+void poly_rem_monic( fp2 *r, fp2 *f, int n, fp2 *g, int m, mpz_t p ) {
+	/* Sets r as f mod g, where f has n coefficients and g has m coefficients.
+	r has m-1 coefficients, and may overlap f.
+	Uses schoolbook division, or Newton iteration when it is cheaper.
+
+	WATCH OUT ! g has to be monic, ie g[m-1] = 1.
+	*/
+	if( n < m ) {
+		for( int i = 0; i < m-1; i++ ) {
+			if( i < n ) {
+				fp2_set( &(r[i]), &(f[i]) );
+			}
+			else {
+				mpz_set_ui( r[i].s0, 0 );
+				mpz_set_ui( r[i].s1, 0 );
+			}
+		}
+		return;
+	}
+
+	int q_len = n-m+1;
+	fp2 *w = poly_new( n );
+	for( int i = 0; i < n; i++ ) {
+		fp2_set( &(w[i]), &(f[i]) );
+	}
+
+	if( poly_rem_cost( n, m ) == ( q_len )*( m-1 ) ) {
+		// Schoolbook division.
+		fp2 tmp;
+		fp2_init_none( &tmp );
+		for( int i = n-1; i >= m-1; i-- ) {
+			for( int j = 0; j < m-1; j++ ) {
+				fp2_mult( &tmp, &(w[i]), &(g[j]), p );
+				fp2_sub( &(w[i-m+1+j]), &(w[i-m+1+j]), &tmp, p );
+			}
+		}
+		fp2_clear( &tmp );
+	}
+	else {
+		// rev(q) = rev(f) / rev(g) mod x^q_len.
+		fp2 *rf = poly_new( q_len );
+		fp2 *rg = poly_new( m );
+		fp2 *inv = poly_new( q_len );
+		fp2 *rq = poly_new( 2*q_len-1 );
+		fp2 *q = poly_new( q_len );
+		fp2 *qg = poly_new( q_len+m-1 );
+
+		for( int i = 0; i < q_len; i++ ) {
+			fp2_set( &(rf[i]), &(f[n-1-i]) );
+		}
+		for( int i = 0; i < m; i++ ) {
+			fp2_set( &(rg[i]), &(g[m-1-i]) );
+		}
+		poly_reciprocal( inv, rg, m, q_len, p );
+		poly_mult( rq, rf, q_len, inv, q_len, p );
+		for( int i = 0; i < q_len; i++ ) {
+			fp2_set( &(q[i]), &(rq[q_len-1-i]) );
+		}
+		poly_mult( qg, q, q_len, g, m, p );
+		for( int i = 0; i < m-1; i++ ) {
+			fp2_sub( &(w[i]), &(w[i]), &(qg[i]), p );
+		}
+
+		poly_free( q_len, rf );
+		poly_free( m, rg );
+		poly_free( q_len, inv );
+		poly_free( 2*q_len-1, rq );
+		poly_free( q_len, q );
+		poly_free( q_len+m-1, qg );
+	}
+
+	for( int i = 0; i < m-1; i++ ) {
+		fp2_set( &(r[i]), &(w[i]) );
+	}
+	poly_free( n, w );
+}
+
+void poly_product( fp2 *h, int k, int deg, fp2 *fac, mpz_t p ) {
+	/* Sets h as the product of the k polynomials of degree deg stored
+	one after the other in fac, ie fac has k*(deg+1) coefficients.
+	h has k*deg+1 coefficients. Uses a balanced product tree.
+	*/
+	if( k == 1 ) {
+		for( int i = 0; i <= deg; i++ ) {
+			fp2_set( &(h[i]), &(fac[i]) );
+		}
+		return;
+	}
+	int k1 = k/2;
+	fp2 *h1 = poly_new( k1*deg+1 );
+	fp2 *h2 = poly_new( (k-k1)*deg+1 );
+	poly_product( h1, k1, deg, fac, p );
+	poly_product( h2, k-k1, deg, fac + k1*(deg+1), p );
+	poly_mult( h, h1, k1*deg+1, h2, (k-k1)*deg+1, p );
+	poly_free( k1*deg+1, h1 );
+	poly_free( (k-k1)*deg+1, h2 );
+}
+
+/* ---------------------------------------------------------
+                       TREE PART
+-----------------------------------------------------------*/
+
+void poly_tree_build( poly_tree *T, int k, fp2 roots[k], mpz_t p ) {
+	/* Builds the product tree of the k linear polynomials (x - roots[i]).
+	The root of T is then the monic polynomial prod( x - roots[i] ).
+	*/
+	T->k = k;
+	T->f = poly_new( k+1 );
+	if( k == 1 ) {
+		fp2_addinv( &(T->f[0]), &(roots[0]), p );
+		mpz_set_ui( T->f[1].s0, 1 );
+		T->left = NULL;
+		T->right = NULL;
+		return;
+	}
+	int k1 = k/2;
+	T->left = malloc( sizeof(poly_tree) );
+	T->right = malloc( sizeof(poly_tree) );
+	poly_tree_build( T->left, k1, roots, p );
+	poly_tree_build( T->right, k-k1, roots + k1, p );
+	poly_mult( T->f, T->left->f, k1+1, T->right->f, k-k1+1, p );
+}
+
+void poly_tree_clear( poly_tree *T ) {
+	/* Clears and frees every node of the product tree T.
+	*/
+	poly_free( T->k+1, T->f );
+	if( T->left != NULL ) {
+		poly_tree_clear( T->left );
+		poly_tree_clear( T->right );
+		free( T->left );
+		free( T->right );
+	}
+}
+
+void poly_tree_eval_prod( fp2 *res, poly_tree *T, fp2 *f, int n, mpz_t p ) {
+	/* Sets res as the product of the f(roots[i]), for the k roots of
+	the product tree T, using a remainder tree. f has n coefficients.
+	Since the root of T is monic, this is the resultant Res( T, f ).
+	*/
+	int len = ( n < T->k+1 ) ? n : T->k;
+	fp2 *r = poly_new( len > 0 ? len : 1 );
+	if( n > T->k ) {
+		poly_rem_monic( r, f, n, T->f, T->k+1, p );
+	}
+	else {
+		for( int i = 0; i < n; i++ ) {
+			fp2_set( &(r[i]), &(f[i]) );
+		}
+	}
+
+	if( T->left == NULL ) {
+		// Leaf : r is the constant f(root).
+		if( len > 0 ) {
+			fp2_set( res, &(r[0]) );
+		}
+		else {
+			mpz_set_ui( res->s0, 0 );
+			mpz_set_ui( res->s1, 0 );
+		}
+	}
+	else {
+		fp2 r2;
+		fp2_init_none( &r2 );
+		poly_tree_eval_prod( res, T->left, r, len, p );
+		poly_tree_eval_prod( &r2, T->right, r, len, p );
+		fp2_mult( res, res, &r2, p );
+		fp2_clear( &r2 );
+	}
+	poly_free( len > 0 ? len : 1, r );
+}
+
+/* ---------------------------------------------------------
+                       COST PART
+-----------------------------------------------------------*/
+
+long poly_mult_cost( int n, int m ) {
+	/* Returns the number of fp2 multiplications done by poly_mult
+	on inputs with n and m coefficients.
+	*/
+	if( n < m ) {
+		return poly_mult_cost( m, n );
+	}
+	if( m <= 0 ) {
+		return 0;
+	}
+	if( m < KARATSUBA_THRESHOLD ) {
+		return (long)n*m;
+	}
+	int k = ( n+1 )/2;
+	if( m <= k ) {
+		return poly_mult_cost( k, m ) + poly_mult_cost( n-k, m );
+	}
+	return 2*poly_mult_cost( k, k ) + poly_mult_cost( n-k, m-k );
+}
+
+static long poly_reciprocal_cost( int n, int k ) {
+	/* Returns the number of fp2 multiplications done by poly_reciprocal.
+	*/
+	long cost = 0;
+	for( int t = 1; t < k; ) {
+		int t2 = ( 2*t < k ) ? 2*t : k;
+		int na = ( n < t2 ) ? n : t2;
+		cost += poly_mult_cost( na, t ) + poly_mult_cost( t2-t, t2-t );
+		t = t2;
+	}
+	return cost;
+}
+
+long poly_rem_cost( int n, int m ) {
+	/* Returns the number of fp2 multiplications done by poly_rem_monic
+	on inputs with n and m coefficients.
+	*/
+	if( n < m ) {
+		return 0;
+	}
+	int q_len = n-m+1;
+	long school = (long)q_len*( m-1 );
+	long newton = poly_reciprocal_cost( m, q_len )
+		+ poly_mult_cost( q_len, q_len ) + poly_mult_cost( q_len, m );
+	return ( school <= newton ) ? school : newton;
+}
+
+long poly_product_cost( int k, int deg ) {
+	/* Returns the number of fp2 multiplications done by poly_product.
+	*/
+	if( k <= 1 ) {
+		return 0;
+	}
+	int k1 = k/2;
+	return poly_product_cost( k1, deg ) + poly_product_cost( k-k1, deg )
+		+ poly_mult_cost( k1*deg+1, (k-k1)*deg+1 );
+}
+
+long poly_tree_build_cost( int k ) {
+	/* Returns the number of fp2 multiplications done by poly_tree_build
+	with k roots.
+	*/
+	return poly_product_cost( k, 1 );
+}
+
+long poly_tree_eval_prod_cost( int k, int n ) {
+	/* Returns the number of fp2 multiplications done by poly_tree_eval_prod
+	on a tree with k roots, and a polynomial with n coefficients.
+	*/
+	int len = ( n < k+1 ) ? n : k;
+	long cost = ( n > k ) ? poly_rem_cost( n, k+1 ) : 0;
+	if( k == 1 ) {
+		return cost;
+	}
+	int k1 = k/2;
+	return cost + 1 + poly_tree_eval_prod_cost( k1, len )
+		+ poly_tree_eval_prod_cost( k-k1, len );
+}
@@ -0,0 +1,161 @@
+/*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*
+*
+* Contains a small pool of worker threads, used to run
+* independent tasks (like images of points by the same
+* isogeny) in parallel.
+*
+*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include <gmp.h>
+#include <pthread.h>
+#include "Header.h"
+
+struct pool {
+	int threads; // number of threads, the calling one included.
+	pthread_t *tid;
+	pthread_mutex_t lock;
+	pthread_mutex_t run; // only one pool_run at a time.
+	pthread_cond_t start;
+	pthread_cond_t done;
+	void (*job)( void *arg, int i );
+	void *arg;
+	int n; // number of tasks of the current run.
+	int next; // index of the next task to start.
+	int pending; // number of tasks not finished yet.
+	int generation; // incremented at each run.
+	int stop;
+};
+
+static void pool_work( pool *W ) {
+	/* Runs the tasks of the current run until there is none left.
+	W->lock has to be held, and is held again when returning.
+	*/
+	while( W->next < W->n ) {
+		int i = W->next++;
+		void (*job)( void *arg, int i ) = W->job;
+		void *arg = W->arg;
+
+		pthread_mutex_unlock( &(W->lock) );
+		job( arg, i );
+		pthread_mutex_lock( &(W->lock) );
+
+		W->pending--;
+		if( W->pending == 0 ) {
+			pthread_cond_broadcast( &(W->done) );
+		}
+	}
+}
+
+static void *pool_worker( void *arg ) {
+	pool *W = (pool *) arg;
+	int seen = 0;
+
+	pthread_mutex_lock( &(W->lock) );
+	while( 1 ) {
+		while( W->generation == seen && !W->stop ) {
+			pthread_cond_wait( &(W->start), &(W->lock) );
+		}
+		if( W->stop ) {
+			break;
+		}
+		seen = W->generation;
+		pool_work( W );
+	}
+	pthread_mutex_unlock( &(W->lock) );
+	return NULL;
+}
+
+pool *pool_new( int threads ) {
+	/* Returns a pool running its tasks on threads threads, the calling
+	one included (so threads-1 workers are started).
+	If a worker can't be started, the pool just has less threads.
+	*/
+	pool *W = malloc( sizeof( pool ) );
+	if( threads < 1 ) {
+		threads = 1;
+	}
+	W->tid = malloc( threads*sizeof( pthread_t ) );
+	pthread_mutex_init( &(W->lock), NULL );
+	pthread_mutex_init( &(W->run), NULL );
+	pthread_cond_init( &(W->start), NULL );
+	pthread_cond_init( &(W->done), NULL );
+	W->job = NULL;
+	W->arg = NULL;
+	W->n = 0;
+	W->next = 0;
+	W->pending = 0;
+	W->generation = 0;
+	W->stop = 0;
+
+	W->threads = 1;
+	for( int t = 1; t < threads; t++ ) {
+		if( pthread_create( &(W->tid[W->threads]), NULL, pool_worker, W ) != 0 ) {
+			break;
+		}
+		W->threads++;
+	}
+	return W;
+}
+
+void pool_free( pool *W ) {
+	/* Stops the workers of W and frees it.
+	*/
+	if( W == NULL ) {
+		return;
+	}
+	pthread_mutex_lock( &(W->lock) );
+	W->stop = 1;
+	pthread_cond_broadcast( &(W->start) );
+	pthread_mutex_unlock( &(W->lock) );
+
+	for( int t = 1; t < W->threads; t++ ) {
+		pthread_join( W->tid[t], NULL );
+	}
+	pthread_mutex_destroy( &(W->lock) );
+	pthread_mutex_destroy( &(W->run) );
+	pthread_cond_destroy( &(W->start) );
+	pthread_cond_destroy( &(W->done) );
+	free( W->tid );
+	free( W );
+}
+
+int pool_threads( pool *W ) {
+	/* Returns the number of threads of W, 1 if W is NULL.
+	*/
+	return ( W == NULL ) ? 1 : W->threads;
+}
+
+void pool_run( pool *W, int n, void (*job)( void *arg, int i ), void *arg ) {
+	/* Runs job( arg, i ) for 0 <= i < n, and returns when all of them
+	are done. The calling thread takes tasks too.
+	If W is NULL, the tasks are run in order by the calling thread.
+	*/
+	if( W == NULL || W->threads == 1 || n <= 1 ) {
+		for( int i = 0; i < n; i++ ) {
+			job( arg, i );
+		}
+		return;
+	}
+
+	pthread_mutex_lock( &(W->run) );
+	pthread_mutex_lock( &(W->lock) );
+	W->job = job;
+	W->arg = arg;
+	W->n = n;
+	W->next = 0;
+	W->pending = n;
+	W->generation++;
+	pthread_cond_broadcast( &(W->start) );
+
+	pool_work( W );
+	while( W->pending > 0 ) {
+		pthread_cond_wait( &(W->done), &(W->lock) );
+	}
+	pthread_mutex_unlock( &(W->lock) );
+	pthread_mutex_unlock( &(W->run) );
+}
@@ -0,0 +1,125 @@
+/*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*
+*
+* Contains the random generation of secrets : bytes from the
+* kernel (getrandom), and a buffered generator expanding a
+* kernel seed with SHAKE256 for bulk generation.
+*
+*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <gmp.h>
+#include <sys/random.h>
+#include "Header.h"
+
+void random_bytes( unsigned char *out, size_t len ) {
+	/* Sets out as len random bytes from the kernel.
+	*/
+	while( len > 0 ) {
+		ssize_t n = getrandom( out, len, 0 );
+		if( n < 0 ) {
+			perror( "getrandom" );
+			exit( 1 );
+		}
+		out += n;
+		len -= n;
+	}
+}
+
+/* --------------------------------------------------------
+ 					DRBG
+----------------------------------------------------------*/
+
+static void drbg_refill( drbg *D ) {
+	/* Sets the buffer and the next key as SHAKE256( key || counter ). 
+	The old key is overwritten, so that the bytes already given can not 
+	be recovered from the state.
+	*/
+	unsigned char in[DRBG_KEY_BYTES + 8];
+	unsigned char out[DRBG_KEY_BYTES + DRBG_BUFFER];
+	memcpy( in, D->key, DRBG_KEY_BYTES );
+	for( int i = 0; i < 8; i++ ) {
+		in[DRBG_KEY_BYTES + i] = D->counter >> ( 8*i );
+	}
+	D->counter++;
+	shake256( out, sizeof( out ), in, sizeof( in ) );
+	memcpy( D->key, out, DRBG_KEY_BYTES );
+	memcpy( D->buf, out + DRBG_KEY_BYTES, DRBG_BUFFER );
+	D->pos = 0;
+	memset( in, 0, sizeof( in ) );
+	memset( out, 0, sizeof( out ) );
+}
+
+void drbg_init( drbg *D ) {
+	/* Initializes D with a seed from the kernel.
+	*/
+	random_bytes( D->key, DRBG_KEY_BYTES );
+	D->counter = 0;
+	D->pos = DRBG_BUFFER; // empty buffer.
+}
+
+void drbg_clear( drbg *D ) {
+	/* Erases the state of D.
+	*/
+	memset( D, 0, sizeof( drbg ) );
+}
+
+void drbg_bytes( drbg *D, unsigned char *out, size_t len ) {
+	/* Sets out as the len next bytes of D, or as len bytes from the
+	kernel if D is NULL. The bytes given are erased from the buffer.
+	*/
+	if( D == NULL ) {
+		random_bytes( out, len );
+		return;
+	}
+	while( len > 0 ) {
+		if( D->pos == DRBG_BUFFER ) {
+			drbg_refill( D );
+		}
+		size_t n = DRBG_BUFFER - D->pos;
+		n = ( len < n ) ? len : n;
+		memcpy( out, D->buf + D->pos, n );
+		memset( D->buf + D->pos, 0, n );
+		D->pos += n;
+		out += n;
+		len -= n;
+	}
+}
+
+/* --------------------------------------------------------
+ 					SECRETS
+----------------------------------------------------------*/
+
+void random_secret( mpz_t s, int l, int e, drbg *D ) {
+	/* Sets s uniformly in {0, ..., l^e-1}, from D (or the kernel if D
+	is NULL). For l = 2 the e bits are drawn exactly, otherwise the
+	values of the bit length of l^e-1 are drawn until one is below l^e
+	(less than 2 tries on average).
+	*/
+	mpz_t q;
+	mpz_init( q );
+	mpz_ui_pow_ui( q, l, e );
+	mpz_sub_ui( q, q, 1 );
+	size_t bits = mpz_sizeinbase( q, 2 );
+	size_t len = ( bits + 7 )/8;
+	unsigned char *buf = malloc( len );
+	do {
+		drbg_bytes( D, buf, len );
+		if( bits%8 ) {
+			buf[len-1] &= ( 1 << ( bits%8 ) ) - 1;
+		}
+		mpz_import( s, len, -1, 1, 0, 0, buf );
+	} while( mpz_cmp( s, q ) > 0 );
+	memset( buf, 0, len );
+	free( buf );
+	mpz_clear( q );
+}
+
+void sk_generate( sk *SK, int l, int e, drbg *D ) {
+	/* Initializes secret key SK with a uniform secret in {0, ..., l^e-1},
+	from D (or the kernel if D is NULL).
+	*/
+	mpz_init( SK->secret );
+	random_secret( SK->secret, l, e, D );
+}
@@ -0,0 +1,133 @@
+/*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*
+*
+* Contains the Keccak-f[1600] permutation and the extendable
+* output function SHAKE256 (FIPS 202), used by the KEM.
+*
+*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <gmp.h>
+#include "Header.h"
+
+#define SHAKE256_RATE 136 // bytes absorbed or squeezed per permutation.
+
+static const uint64_t keccak_rc[24] = {
+	0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808aULL,
+	0x8000000080008000ULL, 0x000000000000808bULL, 0x0000000080000001ULL,
+	0x8000000080008081ULL, 0x8000000000008009ULL, 0x000000000000008aULL,
+	0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000aULL,
+	0x000000008000808bULL, 0x800000000000008bULL, 0x8000000000008089ULL,
+	0x8000000000008003ULL, 0x8000000000008002ULL, 0x8000000000000080ULL,
+	0x000000000000800aULL, 0x800000008000000aULL, 0x8000000080008081ULL,
+	0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL
+};
+
+static const int keccak_pi[25] = { // lane x + 5y goes to y + 5( 2x + 3y mod 5 ).
+	0, 10, 20, 5, 15, 16, 1, 11, 21, 6, 7, 17, 2,
+	12, 22, 23, 8, 18, 3, 13, 14, 24, 9, 19, 4
+};
+
+static const int keccak_rho[25] = { // rotation of lane x + 5y.
+	0, 1, 62, 28, 27, 36, 44, 6, 55, 20, 3, 10, 43,
+	25, 39, 41, 45, 15, 21, 8, 18, 2, 61, 56, 14
+};
+
+static uint64_t rotl( uint64_t x, int n ) {
+	return ( x << n ) | ( x >> ( ( 64-n ) & 63 ) );
+}
+
+static void keccak_f( uint64_t s[25] ) {
+	/* Applies the 24 rounds of Keccak-f[1600] to the state s.
+	Rho and pi are merged in a single pass into a second state, and the
+	theta and chi steps are unrolled on each row.
+	*/
+	uint64_t a[25], b[25], c[5], d[5];
+	memcpy( a, s, sizeof( a ) );
+	for( int r = 0; r < 24; r++ ) {
+		// Theta.
+		for( int i = 0; i < 5; i++ ) {
+			c[i] = a[i] ^ a[i+5] ^ a[i+10] ^ a[i+15] ^ a[i+20];
+		}
+		d[0] = c[4] ^ rotl( c[1], 1 );
+		d[1] = c[0] ^ rotl( c[2], 1 );
+		d[2] = c[1] ^ rotl( c[3], 1 );
+		d[3] = c[2] ^ rotl( c[4], 1 );
+		d[4] = c[3] ^ rotl( c[0], 1 );
+		// Rho and pi : b[y + 5((2x + 3y) mod 5)] = rotl( a[x + 5y] ).
+		for( int i = 0; i < 25; i++ ) {
+			b[keccak_pi[i]] = rotl( a[i] ^ d[i%5], keccak_rho[i] );
+		}
+		// Chi.
+		for( int j = 0; j < 25; j += 5 ) {
+			a[j] = b[j] ^ ( ~b[j+1] & b[j+2] );
+			a[j+1] = b[j+1] ^ ( ~b[j+2] & b[j+3] );
+			a[j+2] = b[j+2] ^ ( ~b[j+3] & b[j+4] );
+			a[j+3] = b[j+3] ^ ( ~b[j+4] & b[j] );
+			a[j+4] = b[j+4] ^ ( ~b[j] & b[j+1] );
+		}
+		// Iota.
+		a[0] ^= keccak_rc[r];
+	}
+	memcpy( s, a, sizeof( a ) );
+}
+
+static void keccak_xor( uint64_t s[25], const unsigned char *in, size_t len ) {
+	/* Xors the len bytes of in into the state, read as little endian lanes.
+	*/
+	size_t i = 0;
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+	for( ; i + 8 <= len; i += 8 ) {
+		uint64_t t;
+		memcpy( &t, in + i, 8 );
+		s[i/8] ^= t;
+	}
+#endif
+	for( ; i < len; i++ ) {
+		s[i/8] ^= (uint64_t) in[i] << ( 8*( i%8 ) );
+	}
+}
+
+static void keccak_extract( unsigned char *out, uint64_t s[25], size_t len ) {
+	/* Sets out as the first len bytes of the state.
+	*/
+	size_t i = 0;
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+	i = len - len%8;
+	memcpy( out, s, i );
+#endif
+	for( ; i < len; i++ ) {
+		out[i] = s[i/8] >> ( 8*( i%8 ) );
+	}
+}
+
+void shake256( unsigned char *out, size_t outlen,
+	const unsigned char *in, size_t inlen ) {
+	/* Sets out as the outlen first bytes of SHAKE256( in ).
+	*/
+	uint64_t s[25];
+	memset( s, 0, sizeof( s ) );
+
+	while( inlen >= SHAKE256_RATE ) {
+		keccak_xor( s, in, SHAKE256_RATE );
+		keccak_f( s );
+		in += SHAKE256_RATE;
+		inlen -= SHAKE256_RATE;
+	}
+	unsigned char block[SHAKE256_RATE];
+	memset( block, 0, SHAKE256_RATE );
+	memcpy( block, in, inlen );
+	block[inlen] ^= 0x1f; // SHAKE domain and first padding bit.
+	block[SHAKE256_RATE-1] ^= 0x80; // last padding bit.
+	keccak_xor( s, block, SHAKE256_RATE );
+
+	while( outlen > 0 ) {
+		keccak_f( s );
+		size_t len = ( outlen < SHAKE256_RATE ) ? outlen : SHAKE256_RATE;
+		keccak_extract( out, s, len );
+		out += len;
+		outlen -= len;
+	}
+}
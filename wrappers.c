@@ -0,0 +1,74 @@
+/*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*
+*
+* Contains encapsulation from key exchange methods, choosing
+* the 2/3 functions or the generalized ones.
+*
+*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*-*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <gmp.h>
+#include "Header.h"
+
+void key_gen_Alice( pk *PKA, sk *SKA, parameters *param, int regular ) {
+	/* Key_generation for Alice. Given a secret key SKA and public parameters param,
+	sets PKA to the associated public key.
+	Uses algorithms for 2/3 only if regular is set to 1.
+	*/
+	if( regular ){
+		isogen_two( PKA, SKA, param );
+	}
+	else{
+		isogen_Alice( PKA, SKA, param );
+	}
+}
+
+void key_gen_Bob( pk *PKB, sk *SKB, parameters *param, int regular ) {
+	/* Key_generation for Bob. Given a secret key SKB and public parameters param,
+	sets PKB to the associated public key.
+	Uses algorithms for 2/3 only if regular is set to 1.
+	*/
+	if( regular ){
+		isogen_three( PKB, SKB, param );
+	}
+	else{
+		isogen_Bob( PKB, SKB, param );
+	}
+}
+
+void key_exchange_Alice( fp2 *jA, sk *SKA, pk *PKB, parameters *param, int regular ) {
+	/* Key exchange for Alice. Given Bob's public key PKB, Alice's own secret key SKA and
+	public parameters param, sets jA to the shared j-invariant jA.
+	Uses algorithms for 2/3 only if regular is set to 1.
+	*/
+	if( regular ){
+		isoex_two( jA, SKA, PKB, param );
+	}
+	else{
+		isoex_Alice( jA, PKB, SKA, param );
+	}
+}
+
+void key_exchange_Bob( fp2 *jB, sk *SKB, pk *PKA, parameters *param, int regular ) {
+	/* Key exchange for Bob. Given Alice's public key PKA, Bob's own secret key SKB and
+	public parameters param, sets jB to the shared j-invariant jB.
+	Uses algorithms for 2/3 only if regular is set to 1.
+	*/
+	if( regular ){
+		isoex_three( jB, SKB, PKA, param );
+	}
+	else{
+		isoex_Bob( jB, PKA, SKB, param );
+	}
+}
+
+void verification( fp2 *jA, fp2 *jB ) {
+	/* Checks if jA and jB are equal over Fp2.
+	*/
+	if( fp2_are_equal( jA, jB ) ){
+		printf("Key exchange worked !! : )\n");
+	}
+	else{
+		printf("Missed... Sorry :'( \n");
+	}
+}
\ No newline at end of file